@@ -66,27 +66,36 @@ namespace jsonschema {
         std::vector<const schema_validator<Json>*> dynamic_scope_;
         jsonpointer::json_pointer eval_path_;
         evaluation_flags flags_;
+        bool track_paths_;
     public:
         evaluation_context()
-            : flags_{}
+            : flags_{}, track_paths_(true)
+        {
+        }
+
+        // Evaluation and instance paths are only needed for error
+        // messages; without them, eval_path() and child_location() are
+        // empty
+        explicit evaluation_context(bool track_paths)
+            : flags_{}, track_paths_(track_paths)
         {
         }
 
         evaluation_context(const evaluation_context& other)
             : dynamic_scope_ { other.dynamic_scope_}, eval_path_{other.eval_path_},
-              flags_(other.flags_)
+              flags_(other.flags_), track_paths_(other.track_paths_)
         {
         }
 
         evaluation_context(evaluation_context&& other)
             : dynamic_scope_{std::move(other.dynamic_scope_)},eval_path_{std::move(other.eval_path_)},
-              flags_(other.flags_)
+              flags_(other.flags_), track_paths_(other.track_paths_)
         {
         }
 
         evaluation_context(const evaluation_context& parent, const schema_validator<Json> *validator)
             : dynamic_scope_ { parent.dynamic_scope_ }, eval_path_{ parent.eval_path_ },
-              flags_(parent.flags_)
+              flags_(parent.flags_), track_paths_(parent.track_paths_)
         {
             if (validator->id() || dynamic_scope_.empty())
             {
@@ -97,7 +106,7 @@ namespace jsonschema {
         evaluation_context(const evaluation_context& parent, const schema_validator<Json> *validator,
             evaluation_flags flags)
             : dynamic_scope_ { parent.dynamic_scope_ }, eval_path_{ parent.eval_path_ },
-              flags_(flags)
+              flags_(flags), track_paths_(parent.track_paths_)
         {
             if (validator->id() || dynamic_scope_.empty())
             {
@@ -106,30 +115,43 @@ namespace jsonschema {
         }
 
         evaluation_context(const evaluation_context& parent, const std::string& name)
-            : dynamic_scope_{parent.dynamic_scope_}, eval_path_(parent.eval_path() / name),
-              flags_(parent.flags_)
+            : dynamic_scope_{parent.dynamic_scope_}, eval_path_(parent.child_path(name)),
+              flags_(parent.flags_), track_paths_(parent.track_paths_)
               
         {
         }
 
         evaluation_context(const evaluation_context& parent, const std::string& name,
             evaluation_flags flags)
-            : dynamic_scope_{parent.dynamic_scope_}, eval_path_(parent.eval_path() / name),
-              flags_(flags)
+            : dynamic_scope_{parent.dynamic_scope_}, eval_path_(parent.child_path(name)),
+              flags_(flags), track_paths_(parent.track_paths_)
         {
         }
 
         evaluation_context(const evaluation_context& parent, std::size_t index)
-            : dynamic_scope_{parent.dynamic_scope_}, eval_path_(parent.eval_path() / index),
-              flags_(parent.flags_)
+            : dynamic_scope_{parent.dynamic_scope_}, eval_path_(parent.child_path(index)),
+              flags_(parent.flags_), track_paths_(parent.track_paths_)
         {
         }
 
         evaluation_context(const evaluation_context& parent, std::size_t index,
             evaluation_flags flags)
-            : dynamic_scope_{parent.dynamic_scope_}, eval_path_(parent.eval_path() / index),
-              flags_(flags)
+            : dynamic_scope_{parent.dynamic_scope_}, eval_path_(parent.child_path(index)),
+              flags_(flags), track_paths_(parent.track_paths_)
+        {
+        }
+
+        // The location of a member or element of the instance at 'location'
+        jsonpointer::json_pointer child_location(const jsonpointer::json_pointer& location,
+            const std::string& name) const
+        {
+            return track_paths_ ? location / name : jsonpointer::json_pointer{};
+        }
+
+        jsonpointer::json_pointer child_location(const jsonpointer::json_pointer& location,
+            std::size_t index) const
         {
+            return track_paths_ ? location / index : jsonpointer::json_pointer{};
         }
 
         const std::vector<const schema_validator<Json>*>& dynamic_scope() const
@@ -156,6 +178,17 @@ namespace jsonschema {
         {
             return (flags_ & evaluation_flags::require_evaluated_items) == evaluation_flags::require_evaluated_items;
         }
+
+    private:
+        jsonpointer::json_pointer child_path(const std::string& name) const
+        {
+            return child_location(eval_path_, name);
+        }
+
+        jsonpointer::json_pointer child_path(std::size_t index) const
+        {
+            return child_location(eval_path_, index);
+        }
     }; 
 
 } // namespace jsonschema
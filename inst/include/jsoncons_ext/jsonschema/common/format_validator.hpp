@@ -12,6 +12,7 @@
 #include <jsoncons/json.hpp>
 #include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
 #include <jsoncons_ext/jsonschema/common/validator.hpp>
+#include <rjsoncons/schema_regex.hpp> // rjsoncons
 #include <cassert>
 #include <set>
 #include <sstream>
@@ -24,6 +25,8 @@
 namespace jsoncons {
 namespace jsonschema {
 
+    using rjsoncons::schema_regex; // rjsoncons
+
     inline
     bool is_atext( char c)
     {
@@ -900,11 +903,14 @@ namespace jsonschema {
         uri::parse(str, ec);
         if (ec)
         {
-            reporter.error(validation_message("uri",
-                eval_path,
-                schema_location, 
-                instance_location, 
-                "'" + str + "' is not a valid URI."));
+            reporter.report([&]
+            {
+                return validation_message("uri",
+                    eval_path,
+                    schema_location, 
+                    instance_location, 
+                    "'" + str + "' is not a valid URI.");
+            });
         }
     }
 
@@ -918,11 +924,14 @@ namespace jsonschema {
         jsonpointer::json_pointer::parse(str, ec);
         if (ec)
         {
-            reporter.error(validation_message("json-pointer",
-                eval_path,
-                schema_location, 
-                instance_location, 
-                "'" + str + "' is not a valid JSONPointer."));
+            reporter.report([&]
+            {
+                return validation_message("json-pointer",
+                    eval_path,
+                    schema_location, 
+                    instance_location, 
+                    "'" + str + "' is not a valid JSONPointer.");
+            });
         }
     }
 
@@ -935,11 +944,14 @@ namespace jsonschema {
     {
         if (!validate_date_time_rfc3339(value,date_time_type::date))
         {
-            reporter.error(validation_message("date",
-                eval_path,
-                schema_location, 
-                instance_location, 
-                "'" + value + "' is not a RFC 3339 date string."));
+            reporter.report([&]
+            {
+                return validation_message("date",
+                    eval_path,
+                    schema_location, 
+                    instance_location, 
+                    "'" + value + "' is not a RFC 3339 date string.");
+            });
         }
     }
 
@@ -951,11 +963,14 @@ namespace jsonschema {
     {
         if (!validate_date_time_rfc3339(value, date_time_type::time))        
         {
-            reporter.error(validation_message("time", 
-                eval_path,
-                schema_location, 
-                instance_location, 
-                "'" + value + "' is not a RFC 3339 time string."));
+            reporter.report([&]
+            {
+                return validation_message("time", 
+                    eval_path,
+                    schema_location, 
+                    instance_location, 
+                    "'" + value + "' is not a RFC 3339 time string.");
+            });
         }
     }
 
@@ -967,11 +982,14 @@ namespace jsonschema {
     {
         if (!validate_date_time_rfc3339(value, date_time_type::date_time))        
         {
-            reporter.error(validation_message("date-time", 
-                eval_path,  
-                schema_location,
-                instance_location, 
-                "'" + value + "' is not a RFC 3339 date-time string."));
+            reporter.report([&]
+            {
+                return validation_message("date-time", 
+                    eval_path,  
+                    schema_location,
+                    instance_location, 
+                    "'" + value + "' is not a RFC 3339 date-time string.");
+            });
         }
     }
 
@@ -983,11 +1001,14 @@ namespace jsonschema {
     {
         if (!validate_email_rfc5322(value))        
         {
-            reporter.error(validation_message("email", 
-                eval_path, 
-                schema_location, 
-                instance_location, 
-                "'" + value + "' is not a valid email address as defined by RFC 5322."));
+            reporter.report([&]
+            {
+                return validation_message("email", 
+                    eval_path, 
+                    schema_location, 
+                    instance_location, 
+                    "'" + value + "' is not a valid email address as defined by RFC 5322.");
+            });
         }
     } 
 
@@ -999,11 +1020,14 @@ namespace jsonschema {
     {
         if (!validate_hostname_rfc1034(value))
         {
-            reporter.error(validation_message("hostname", 
-                eval_path, 
-                schema_location, 
-                instance_location, 
-                "'" + value + "' is not a valid hostname as defined by RFC 3986 Appendix A."));
+            reporter.report([&]
+            {
+                return validation_message("hostname", 
+                    eval_path, 
+                    schema_location, 
+                    instance_location, 
+                    "'" + value + "' is not a valid hostname as defined by RFC 3986 Appendix A.");
+            });
         }
     } 
 
@@ -1015,11 +1039,14 @@ namespace jsonschema {
     {
         if (!validate_ipv4_rfc2673(value))
         {
-            reporter.error(validation_message("ipv4", 
-                eval_path, 
-                schema_location, 
-                instance_location, 
-                "'" + value + "' is not a valid IPv4 address as defined by RFC 2673."));
+            reporter.report([&]
+            {
+                return validation_message("ipv4", 
+                    eval_path, 
+                    schema_location, 
+                    instance_location, 
+                    "'" + value + "' is not a valid IPv4 address as defined by RFC 2673.");
+            });
         }
     } 
 
@@ -1031,11 +1058,14 @@ namespace jsonschema {
     {
         if (!validate_ipv6_rfc2373(value))
         {
-            reporter.error(validation_message("ipv6", 
-                eval_path, 
-                schema_location, 
-                instance_location, 
-                "'" + value + "' is not a valid IPv6 address as defined by RFC 2373."));
+            reporter.report([&]
+            {
+                return validation_message("ipv6", 
+                    eval_path, 
+                    schema_location, 
+                    instance_location, 
+                    "'" + value + "' is not a valid IPv6 address as defined by RFC 2373.");
+            });
         }
     } 
 
@@ -1048,15 +1078,18 @@ namespace jsonschema {
 #if defined(JSONCONS_HAS_STD_REGEX)
         try 
         {
-            std::regex re(value, std::regex::ECMAScript);
+            schema_regex re(value);
         } 
         catch (const std::exception& e) 
         {
-            reporter.error(validation_message("pattern", 
-                eval_path, 
-                schema_location, 
-                instance_location, 
-                "'" + value + "' is not a valid ECMAScript regular expression. " + e.what()));
+            reporter.report([&]
+            {
+                return validation_message("pattern", 
+                    eval_path, 
+                    schema_location, 
+                    instance_location, 
+                    "'" + value + "' is not a valid ECMAScript regular expression. " + e.what());
+            });
         }
 #endif
     } 
@@ -13,6 +13,7 @@
 #include <jsoncons/json.hpp>
 #include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
 #include <jsoncons_ext/jsonschema/common/format_validator.hpp>
+#include <rjsoncons/schema_regex.hpp> // rjsoncons
 #include <jsoncons_ext/jsonschema/common/validator.hpp>
 #include <jsoncons_ext/jsonschema/common/uri_wrapper.hpp>
 #include <cassert>
@@ -28,6 +29,8 @@
 namespace jsoncons {
 namespace jsonschema {
 
+    using rjsoncons::schema_regex; // rjsoncons
+
     template <class Json>
     class schema_keyword_validator : public keyword_validator_base<Json>
     {
@@ -120,11 +123,14 @@ namespace jsonschema {
             evaluation_context<Json> this_context(context, this->keyword_name());
             if (schema_ptr == nullptr)
             {
-                reporter.error(validation_message(this->keyword_name(), 
-                    this_context.eval_path(),
-                    this->schema_location(), 
-                    instance_location, 
-                    "Unresolved schema reference " + this->schema_location().string()));
+                reporter.report([&]
+                {
+                    return validation_message(this->keyword_name(), 
+                        this_context.eval_path(),
+                        this->schema_location(), 
+                        instance_location, 
+                        "Unresolved schema reference " + this->schema_location().string());
+                });
                 return;
             }
 
@@ -246,11 +252,14 @@ namespace jsonschema {
                 auto retval = jsoncons::decode_base64(s.begin(), s.end(), content);
                 if (retval.ec != jsoncons::conv_errc::success)
                 {
-                    reporter.error(validation_message(this->keyword_name(),
-                        this_context.eval_path(), 
-                        this->schema_location(), 
-                        instance_location, 
-                        "Content is not a base64 string"));
+                    reporter.report([&]
+                    {
+                        return validation_message(this->keyword_name(),
+                            this_context.eval_path(), 
+                            this->schema_location(), 
+                            instance_location, 
+                            "Content is not a base64 string");
+                    });
                     if (reporter.fail_early())
                     {
                         return;
@@ -259,11 +268,14 @@ namespace jsonschema {
             }
             else if (!content_encoding_.empty())
             {
-                reporter.error(validation_message(this->keyword_name(),
-                    this_context.eval_path(), 
-                    this->schema_location(),
-                    instance_location, 
-                    "unable to check for contentEncoding '" + content_encoding_ + "'"));
+                reporter.report([&]
+                {
+                    return validation_message(this->keyword_name(),
+                        this_context.eval_path(), 
+                        this->schema_location(),
+                        instance_location, 
+                        "unable to check for contentEncoding '" + content_encoding_ + "'");
+                });
                 if (reporter.fail_early())
                 {
                     return;
@@ -325,11 +337,14 @@ namespace jsonschema {
 
                 if (ec)
                 {
-                    reporter.error(validation_message(this->keyword_name(),
-                        this_context.eval_path(), 
-                        this->schema_location(), 
-                        instance_location, 
-                        std::string("Content is not JSON: ") + ec.message()));
+                    reporter.report([&]
+                    {
+                        return validation_message(this->keyword_name(),
+                            this_context.eval_path(), 
+                            this->schema_location(), 
+                            instance_location, 
+                            std::string("Content is not JSON: ") + ec.message());
+                    });
                 }
             }
         }
@@ -387,11 +402,11 @@ namespace jsonschema {
         using keyword_validator_type = std::unique_ptr<keyword_validator<Json>>;
 
         std::string pattern_string_;
-        std::regex regex_;
+        schema_regex regex_;
 
     public:
         pattern_validator(const uri& schema_location,
-            const std::string& pattern_string, const std::regex& regex)
+            const std::string& pattern_string, const schema_regex& regex)
             : keyword_validator_base<Json>("pattern", schema_location), 
               pattern_string_(pattern_string), regex_(regex)
         {
@@ -413,18 +428,21 @@ namespace jsonschema {
             evaluation_context<Json> this_context(context, this->keyword_name());
 
             auto s = instance.template as<std::string>();
-            if (!std::regex_search(s, regex_))
-            {
-                std::string message("String '");
-                message.append(s);
-                message.append("' does not match pattern '");
-                message.append(pattern_string_);
-                message.append("'.");
-                reporter.error(validation_message(this->keyword_name(),
-                    this_context.eval_path(), 
-                    this->schema_location(),
-                    instance_location, 
-                    std::move(message)));
+            if (!regex_.search(s))
+            {
+                reporter.report([&]
+                {
+                    std::string message("String '");
+                    message.append(s);
+                    message.append("' does not match pattern '");
+                    message.append(pattern_string_);
+                    message.append("'.");
+                    return validation_message(this->keyword_name(),
+                        this_context.eval_path(), 
+                        this->schema_location(),
+                        instance_location, 
+                        std::move(message));
+                });
                 if (reporter.fail_early())
                 {
                     return;
@@ -489,12 +507,15 @@ namespace jsonschema {
             std::size_t length = unicode_traits::count_codepoints(sv.data(), sv.size());
             if (length > max_length_)
             {
-                reporter.error(validation_message(this->keyword_name(),
-                        this_context.eval_path(), 
-                        this->schema_location(), 
-                        instance_location, 
-                        std::string("Expected maxLength: ") + std::to_string(max_length_)
-                    + ", actual: " + std::to_string(length)));
+                reporter.report([&]
+                {
+                    return validation_message(this->keyword_name(),
+                            this_context.eval_path(), 
+                            this->schema_location(), 
+                            instance_location, 
+                            std::string("Expected maxLength: ") + std::to_string(max_length_)
+                        + ", actual: " + std::to_string(length));
+                });
                 if (reporter.fail_early())
                 {
                     return;
@@ -534,13 +555,16 @@ namespace jsonschema {
 
             if (instance.size() > max_items_)
             {
-                std::string message("Maximum number of items is " + std::to_string(max_items_));
-                message.append(" but found: " + std::to_string(instance.size()));
-                reporter.error(validation_message(this->keyword_name(),
-                        this_context.eval_path(), 
-                        this->schema_location(),
-                        instance_location, 
-                        std::move(message)));
+                reporter.report([&]
+                {
+                    std::string message("Maximum number of items is " + std::to_string(max_items_));
+                    message.append(" but found: " + std::to_string(instance.size()));
+                    return validation_message(this->keyword_name(),
+                            this_context.eval_path(), 
+                            this->schema_location(),
+                            instance_location, 
+                            std::move(message));
+                });
                 if (reporter.fail_early())
                 {
                     return;
@@ -580,13 +604,16 @@ namespace jsonschema {
 
             if (instance.size() < min_items_)
             {
-                std::string message("Minimum number of items is " + std::to_string(min_items_));
-                message.append(" but found: " + std::to_string(instance.size()));
-                reporter.error(validation_message(this->keyword_name(),
-                        this_context.eval_path(), 
-                        this->schema_location(),
-                        instance_location, 
-                        std::move(message)));
+                reporter.report([&]
+                {
+                    std::string message("Minimum number of items is " + std::to_string(min_items_));
+                    message.append(" but found: " + std::to_string(instance.size()));
+                    return validation_message(this->keyword_name(),
+                            this_context.eval_path(), 
+                            this->schema_location(),
+                            instance_location, 
+                            std::move(message));
+                });
                 if (reporter.fail_early())
                 {
                     return;
@@ -631,12 +658,15 @@ namespace jsonschema {
             {
                 if (schema_val_->always_fails())
                 {
-                    jsonpointer::json_pointer item_location = instance_location / 0;
-                    reporter.error(validation_message(this->keyword_name(),
-                        this_context.eval_path(), 
-                        this->schema_location(), 
-                        item_location,
-                        "Item at index '0' but the schema does not allow any items."));
+                    jsonpointer::json_pointer item_location = context.child_location(instance_location, 0);
+                    reporter.report([&]
+                    {
+                        return validation_message(this->keyword_name(),
+                            this_context.eval_path(), 
+                            this->schema_location(), 
+                            item_location,
+                            "Item at index '0' but the schema does not allow any items.");
+                    });
                     return;
                 }
                 else if (schema_val_->always_succeeds())
@@ -653,9 +683,13 @@ namespace jsonschema {
                     size_t end = 0;
                     for (const auto& item : instance.array_range()) 
                     {
-                        jsonpointer::json_pointer item_location = instance_location / index;
+                        jsonpointer::json_pointer item_location = context.child_location(instance_location, index);
                         std::size_t errors = reporter.error_count();
                         schema_val_->validate(this_context, item, item_location, results, reporter, patch);
+                        if (reporter.error_count() > errors && !reporter.messages())
+                        {
+                            return;
+                        }
                         if (errors == reporter.error_count())
                         {
                             if (context.require_evaluated_items())
@@ -720,11 +754,14 @@ namespace jsonschema {
 
             if (are_unique_ && !array_has_unique_items(instance))
             {
-                reporter.error(validation_message(this->keyword_name(),
-                    this_context.eval_path(), 
-                    this->schema_location(), 
-                    instance_location, 
-                    "Array items are not unique"));
+                reporter.report([&]
+                {
+                    return validation_message(this->keyword_name(),
+                        this_context.eval_path(), 
+                        this->schema_location(), 
+                        instance_location, 
+                        "Array items are not unique");
+                });
                 if (reporter.fail_early())
                 {
                     return;
@@ -782,12 +819,15 @@ namespace jsonschema {
             std::size_t length = unicode_traits::count_codepoints(sv.data(), sv.size());
             if (length < min_length_) 
             {
-                reporter.error(validation_message(this->keyword_name(),
-                    this_context.eval_path(), 
-                    this->schema_location(), 
-                    instance_location, 
-                    std::string("Expected minLength: ") + std::to_string(min_length_)
-                                          + ", actual: " + std::to_string(length)));
+                reporter.report([&]
+                {
+                    return validation_message(this->keyword_name(),
+                        this_context.eval_path(), 
+                        this->schema_location(), 
+                        instance_location, 
+                        std::string("Expected minLength: ") + std::to_string(min_length_)
+                                              + ", actual: " + std::to_string(length));
+                });
                 if (reporter.fail_early())
                 {
                     return;
@@ -834,17 +874,23 @@ namespace jsonschema {
         {
             evaluation_context<Json> this_context(context, this->keyword_name());
 
+            // the results of a failing schema are kept, so without
+            // messages it may only fail early if they are not needed
+            bool messages = reporter.messages() || context.require_evaluated_properties() || context.require_evaluated_items();
             evaluation_results local_results;
-            collecting_error_reporter local_reporter;
+            collecting_error_reporter local_reporter(messages);
             schema_val_->validate(this_context, instance, instance_location, local_results, local_reporter, patch);
 
-            if (local_reporter.errors.empty())
+            if (local_reporter.error_count() == 0)
             {
-                reporter.error(validation_message(this->keyword_name(),
-                    this_context.eval_path(), 
-                    this->schema_location(), 
-                    instance_location, 
-                    "Instance must not be valid against schema"));
+                reporter.report([&]
+                {
+                    return validation_message(this->keyword_name(),
+                        this_context.eval_path(), 
+                        this->schema_location(), 
+                        instance_location, 
+                        "Instance must not be valid against schema");
+                });
             }
             else
             {
@@ -890,12 +936,20 @@ namespace jsonschema {
                 evaluation_results local_results2;
                 evaluation_context<Json> item_context(this_context, i);
 
-                std::size_t errors = local_reporter.errors.size();
-                validators_[i]->validate(item_context, instance, instance_location, local_results2, local_reporter, patch);
-                if (errors == local_reporter.errors.size())
+                // without messages, each schema fails early on its own
+                collecting_error_reporter schema_reporter(false);
+                error_reporter& item_reporter = reporter.messages() ? local_reporter : schema_reporter;
+                std::size_t errors = item_reporter.error_count();
+                validators_[i]->validate(item_context, instance, instance_location, local_results2, item_reporter, patch);
+                if (errors == item_reporter.error_count())
                 {
                     local_results1.merge(local_results2);
                     ++count;
+                    if (!reporter.messages() && !context.require_evaluated_properties() &&
+                        !context.require_evaluated_items())
+                    {
+                        break;
+                    }
                 }
                 //std::cout << "success: " << i << " " << success << "\n";
             }
@@ -906,12 +960,15 @@ namespace jsonschema {
             }
             else 
             {
-                reporter.error(validation_message(this->keyword_name(),
-                    this_context.eval_path(), 
-                    this->schema_location(), 
-                    instance_location, 
-                    "No schema matched, but at least one of them is required to match", 
-                    local_reporter.errors));
+                reporter.report([&]
+                {
+                    return validation_message(this->keyword_name(),
+                        this_context.eval_path(), 
+                        this->schema_location(), 
+                        instance_location, 
+                        "No schema matched, but at least one of them is required to match", 
+                        local_reporter.errors);
+                });
             }
         }
     };
@@ -953,12 +1010,19 @@ namespace jsonschema {
                 evaluation_results local_results2;
                 evaluation_context<Json> item_context(this_context, i);
 
-                std::size_t errors = local_reporter.errors.size();
-                validators_[i]->validate(item_context, instance, instance_location, local_results2, local_reporter, patch);
-                if (errors == local_reporter.errors.size())
+                // without messages, each schema fails early on its own
+                collecting_error_reporter schema_reporter(false);
+                error_reporter& item_reporter = reporter.messages() ? local_reporter : schema_reporter;
+                std::size_t errors = item_reporter.error_count();
+                validators_[i]->validate(item_context, instance, instance_location, local_results2, item_reporter, patch);
+                if (errors == item_reporter.error_count())
                 {
                     local_results1.merge(local_results2);
                     ++count;
+                    if (!reporter.messages() && count > 1)
+                    {
+                        break;
+                    }
                 }
                 //std::cout << "success: " << i << " " << success << "\n";
             }
@@ -969,12 +1033,15 @@ namespace jsonschema {
             }
             else 
             {
-                reporter.error(validation_message(this->keyword_name(),
-                    this_context.eval_path(), 
-                    this->schema_location(), 
-                    instance_location, 
-                    "No schema matched, but exactly one of them is required to match", 
-                    local_reporter.errors));
+                reporter.report([&]
+                {
+                    return validation_message(this->keyword_name(),
+                        this_context.eval_path(), 
+                        this->schema_location(), 
+                        instance_location, 
+                        "No schema matched, but exactly one of them is required to match", 
+                        local_reporter.errors);
+                });
             }
         }
     };
@@ -1016,18 +1083,25 @@ namespace jsonschema {
                 evaluation_results local_results2;
                 evaluation_context<Json> item_context(this_context, i);
 
-                std::size_t errors = local_reporter.errors.size();
-                validators_[i]->validate(item_context, instance, instance_location, local_results2, local_reporter, patch);
+                // without messages, each schema fails early on its own
+                collecting_error_reporter schema_reporter(false);
+                error_reporter& item_reporter = reporter.messages() ? local_reporter : schema_reporter;
+                std::size_t errors = item_reporter.error_count();
+                validators_[i]->validate(item_context, instance, instance_location, local_results2, item_reporter, patch);
                 //std::cout << "local_results2:\n";
                 //for (const auto& s : local_results2.evaluated_items)
                 //{
                 //    std::cout << "    " << s << "\n";
                 //}
-                if (errors == local_reporter.errors.size())
+                if (errors == item_reporter.error_count())
                 {
                     local_results1.merge(local_results2);
                     ++count;
                 }
+                else if (!reporter.messages())
+                {
+                    break;
+                }
                 //std::cout << "success: " << i << " " << success << "\n";
             }
 
@@ -1043,12 +1117,15 @@ namespace jsonschema {
             }
             else 
             {
-                reporter.error(validation_message(this->keyword_name(),
-                    this_context.eval_path(), 
-                    this->schema_location(), 
-                    instance_location, 
-                    "No schema matched, but all of them are required to match", 
-                    local_reporter.errors));
+                reporter.report([&]
+                {
+                    return validation_message(this->keyword_name(),
+                        this_context.eval_path(), 
+                        this->schema_location(), 
+                        instance_location, 
+                        "No schema matched, but all of them are required to match", 
+                        local_reporter.errors);
+                });
             }
         }
     };
@@ -1085,11 +1162,14 @@ namespace jsonschema {
                 {
                     if (instance.template as<int64_t>() > value_.template as<int64_t>())
                     {
-                        reporter.error(validation_message(this->keyword_name(),
-                            this_context.eval_path(), 
-                            this->schema_location(), 
-                            instance_location, 
-                            instance.template as<std::string>() + message_));
+                        reporter.report([&]
+                        {
+                            return validation_message(this->keyword_name(),
+                                this_context.eval_path(), 
+                                this->schema_location(), 
+                                instance_location, 
+                                instance.template as<std::string>() + message_);
+                        });
                     }
                     break;
                 }
@@ -1097,11 +1177,14 @@ namespace jsonschema {
                 {
                     if (instance.template as<double>() > value_.template as<double>())
                     {
-                        reporter.error(validation_message(this->keyword_name(),
-                            this_context.eval_path(), 
-                            this->schema_location(), 
-                            instance_location, 
-                            instance.template as<std::string>() + message_));
+                        reporter.report([&]
+                        {
+                            return validation_message(this->keyword_name(),
+                                this_context.eval_path(), 
+                                this->schema_location(), 
+                                instance_location, 
+                                instance.template as<std::string>() + message_);
+                        });
                     }
                     break;
                 }
@@ -1143,11 +1226,14 @@ namespace jsonschema {
                 {
                     if (instance.template as<int64_t>() >= value_.template as<int64_t>())
                     {
-                        reporter.error(validation_message(this->keyword_name(),
-                            this_context.eval_path(), 
-                            this->schema_location(), 
-                            instance_location, 
-                            instance.template as<std::string>() + message_));
+                        reporter.report([&]
+                        {
+                            return validation_message(this->keyword_name(),
+                                this_context.eval_path(), 
+                                this->schema_location(), 
+                                instance_location, 
+                                instance.template as<std::string>() + message_);
+                        });
                     }
                     break;
                 }
@@ -1155,11 +1241,14 @@ namespace jsonschema {
                 {
                     if (instance.template as<double>() >= value_.template as<double>())
                     {
-                        reporter.error(validation_message(this->keyword_name(),
-                            this_context.eval_path(), 
-                            this->schema_location(), 
-                            instance_location, 
-                            instance.template as<std::string>() + message_));
+                        reporter.report([&]
+                        {
+                            return validation_message(this->keyword_name(),
+                                this_context.eval_path(), 
+                                this->schema_location(), 
+                                instance_location, 
+                                instance.template as<std::string>() + message_);
+                        });
                     }
                     break;
                 }
@@ -1201,11 +1290,14 @@ namespace jsonschema {
                 {
                     if (instance.template as<int64_t>() < value_.template as<int64_t>())
                     {
-                        reporter.error(validation_message(this->keyword_name(),
-                            this_context.eval_path(), 
-                            this->schema_location(), 
-                            instance_location, 
-                            instance.template as<std::string>() + message_));
+                        reporter.report([&]
+                        {
+                            return validation_message(this->keyword_name(),
+                                this_context.eval_path(), 
+                                this->schema_location(), 
+                                instance_location, 
+                                instance.template as<std::string>() + message_);
+                        });
                     }
                     break;
                 }
@@ -1213,11 +1305,14 @@ namespace jsonschema {
                 {
                     if (instance.template as<double>() < value_.template as<double>())
                     {
-                        reporter.error(validation_message(this->keyword_name(),
-                            this_context.eval_path(), 
-                            this->schema_location(), 
-                            instance_location, 
-                            instance.template as<std::string>() + message_));
+                        reporter.report([&]
+                        {
+                            return validation_message(this->keyword_name(),
+                                this_context.eval_path(), 
+                                this->schema_location(), 
+                                instance_location, 
+                                instance.template as<std::string>() + message_);
+                        });
                     }
                     break;
                 }
@@ -1259,11 +1354,14 @@ namespace jsonschema {
                 {
                     if (instance.template as<int64_t>() <= value_.template as<int64_t>())
                     {
-                        reporter.error(validation_message(this->keyword_name(),
-                            this_context.eval_path(), 
-                            this->schema_location(), 
-                            instance_location, 
-                            instance.template as<std::string>() + message_));
+                        reporter.report([&]
+                        {
+                            return validation_message(this->keyword_name(),
+                                this_context.eval_path(), 
+                                this->schema_location(), 
+                                instance_location, 
+                                instance.template as<std::string>() + message_);
+                        });
                     }
                     break;
                 }
@@ -1271,11 +1369,14 @@ namespace jsonschema {
                 {
                     if (instance.template as<double>() <= value_.template as<double>())
                     {
-                        reporter.error(validation_message(this->keyword_name(),
-                            this_context.eval_path(), 
-                            this->schema_location(), 
-                            instance_location, 
-                            instance.template as<std::string>() + message_));
+                        reporter.report([&]
+                        {
+                            return validation_message(this->keyword_name(),
+                                this_context.eval_path(), 
+                                this->schema_location(), 
+                                instance_location, 
+                                instance.template as<std::string>() + message_);
+                        });
                     }
                     break;
                 }
@@ -1317,11 +1418,14 @@ namespace jsonschema {
             {
                 if (!is_multiple_of(value, static_cast<double>(value_)))
                 {
-                    reporter.error(validation_message(this->keyword_name(),
-                        this_context.eval_path(), 
-                        this->schema_location(),
-                        instance_location, 
-                        instance.template as<std::string>() + " is not a multiple of " + std::to_string(value_)));
+                    reporter.report([&]
+                    {
+                        return validation_message(this->keyword_name(),
+                            this_context.eval_path(), 
+                            this->schema_location(),
+                            instance_location, 
+                            instance.template as<std::string>() + " is not a multiple of " + std::to_string(value_));
+                    });
                 }
             }
         }
@@ -1372,11 +1476,14 @@ namespace jsonschema {
             {
                 if(instance.find(key) == instance.object_range().end())
                 {
-                        reporter.error(validation_message(this->keyword_name(),
-                                                         this_context.eval_path(),
-                                                         this->schema_location(),
-                                                         instance_location,
-                                                         "Required property '" + key + "' not found."));
+                        reporter.report([&]
+                        {
+                            return validation_message(this->keyword_name(),
+                                                             this_context.eval_path(),
+                                                             this->schema_location(),
+                                                             instance_location,
+                                                             "Required property '" + key + "' not found.");
+                        });
                         if(reporter.fail_early())
                     {
                             return;
@@ -1418,13 +1525,16 @@ namespace jsonschema {
             {
                 evaluation_context<Json> this_context(context, this->keyword_name());
 
-                std::string message("Maximum properties: " + std::to_string(max_properties_));
-                message.append(", found: " + std::to_string(instance.size()));
-                reporter.error(validation_message(this->keyword_name(),
-                    this_context.eval_path(), 
-                    this->schema_location(), 
-                    instance_location, 
-                    std::move(message)));
+                reporter.report([&]
+                {
+                    std::string message("Maximum properties: " + std::to_string(max_properties_));
+                    message.append(", found: " + std::to_string(instance.size()));
+                    return validation_message(this->keyword_name(),
+                        this_context.eval_path(), 
+                        this->schema_location(), 
+                        instance_location, 
+                        std::move(message));
+                });
             }           
         }
     };
@@ -1459,13 +1569,16 @@ namespace jsonschema {
             {
                 evaluation_context<Json> this_context(context, this->keyword_name());
 
-                std::string message("Maximum properties: " + std::to_string(min_properties_));
-                message.append(", found: " + std::to_string(instance.size()));
-                reporter.error(validation_message(this->keyword_name(),
-                        this_context.eval_path(),
-                        this->schema_location(),
-                        instance_location,
-                        std::move(message)));
+                reporter.report([&]
+                {
+                    std::string message("Maximum properties: " + std::to_string(min_properties_));
+                    message.append(", found: " + std::to_string(instance.size()));
+                    return validation_message(this->keyword_name(),
+                            this_context.eval_path(),
+                            this->schema_location(),
+                            instance_location,
+                            std::move(message));
+                });
             }
             
         }
@@ -1504,7 +1617,7 @@ namespace jsonschema {
             evaluation_context<Json> this_context(context, this->keyword_name());
             if (if_val_) 
             {
-                collecting_error_reporter local_reporter;
+                collecting_error_reporter local_reporter(reporter.messages());
                 evaluation_results local_results;
                 
                 if_val_->validate(this_context, instance, instance_location, local_results, local_reporter, patch);
@@ -1513,7 +1626,7 @@ namespace jsonschema {
                 //{
                 //    std::cout << "  " << item << "\n";
                 //}
-                if (local_reporter.errors.empty()) 
+                if (local_reporter.error_count() == 0) 
                 {
                     results.merge(local_results);
                     if (then_val_)
@@ -1579,11 +1692,14 @@ namespace jsonschema {
 
             if (!in_range)
             {
-                reporter.error(validation_message(this->keyword_name(),
-                    this_context.eval_path(), 
-                    this->schema_location(), 
-                    instance_location, 
-                    "'" + instance.template as<std::string>() + "' is not a valid enum value."));
+                reporter.report([&]
+                {
+                    return validation_message(this->keyword_name(),
+                        this_context.eval_path(), 
+                        this->schema_location(), 
+                        instance_location, 
+                        "'" + instance.template as<std::string>() + "' is not a valid enum value.");
+                });
                 if (reporter.fail_early())
                 {
                     return;
@@ -1619,11 +1735,14 @@ namespace jsonschema {
             {
                 evaluation_context<Json> this_context(context, this->keyword_name());
 
-                reporter.error(validation_message(this->keyword_name(),
-                    this_context.eval_path(), 
-                    this->schema_location(), 
-                    instance_location, 
-                    "Instance is not const"));
+                reporter.report([&]
+                {
+                    return validation_message(this->keyword_name(),
+                        this_context.eval_path(), 
+                        this->schema_location(), 
+                        instance_location, 
+                        "Instance is not const");
+                });
             }
         }
     };
@@ -1750,27 +1869,30 @@ namespace jsonschema {
 
             if (!is_type_found)
             {
-                std::string message = "Expected ";
-                for (std::size_t i = 0; i < expected_types_.size(); ++i)
+                reporter.report([&]
                 {
-                        if (i > 0)
-                        { 
-                            message.append(", ");
-                            if (i+1 == expected_types_.size())
+                    std::string message = "Expected ";
+                    for (std::size_t i = 0; i < expected_types_.size(); ++i)
+                    {
+                            if (i > 0)
                             { 
-                                message.append("or ");
+                                message.append(", ");
+                                if (i+1 == expected_types_.size())
+                                { 
+                                    message.append("or ");
+                                }
                             }
-                        }
-                        message.append(to_string(expected_types_[i]));
-                }
-                message.append(", found ");
-                message.append(to_schema_type(instance.type()));
+                            message.append(to_string(expected_types_[i]));
+                    }
+                    message.append(", found ");
+                    message.append(to_schema_type(instance.type()));
 
-                reporter.error(validation_message(this->keyword_name(),
-                    this_context.eval_path(), 
-                    this->schema_location(), 
-                    instance_location, 
-                    message));
+                    return validation_message(this->keyword_name(),
+                        this_context.eval_path(), 
+                        this->schema_location(), 
+                        instance_location, 
+                        message);
+                });
             }
         }
         
@@ -1862,11 +1984,15 @@ namespace jsonschema {
                 if (properties_it != properties_.end()) 
                 {
                     evaluation_context<Json> prop_context{this_context, prop.key(), evaluation_flags{}};
-                    jsonpointer::json_pointer prop_location = instance_location / prop.key();
+                    jsonpointer::json_pointer prop_location = context.child_location(instance_location, prop.key());
 
                     std::size_t errors = reporter.error_count();
                     properties_it->second->validate(prop_context, prop.value() , prop_location, results, reporter, patch);
                     allowed_properties.insert(prop.key());
+                    if (reporter.error_count() > errors && !reporter.messages())
+                    {
+                        return;
+                    }
                     if (errors == reporter.error_count())
                     {
                         if (context.require_evaluated_properties())
@@ -1932,11 +2058,11 @@ namespace jsonschema {
     {
         using keyword_validator_type = typename keyword_validator<Json>::keyword_validator_type;
         using schema_validator_type = typename schema_validator<Json>::schema_validator_type;
-        std::vector<std::pair<std::regex, schema_validator_type>> pattern_properties_;
+        std::vector<std::pair<schema_regex, schema_validator_type>> pattern_properties_;
 
     public:
         pattern_properties_validator(const uri& schema_location,
-            std::vector<std::pair<std::regex, schema_validator_type>>&& pattern_properties
+            std::vector<std::pair<schema_regex, schema_validator_type>>&& pattern_properties
         )
             : keyword_validator_base<Json>("patternProperties", std::move(schema_location)),
               pattern_properties_(std::move(pattern_properties))
@@ -1959,15 +2085,19 @@ namespace jsonschema {
             for (const auto& prop : instance.object_range()) 
             {
                 evaluation_context<Json> prop_context{this_context, prop.key(), evaluation_flags{}};
-                jsonpointer::json_pointer prop_location = instance_location / prop.key();
+                jsonpointer::json_pointer prop_location = context.child_location(instance_location, prop.key());
 
                 // check all matching "patternProperties"
                 for (auto& schema_pp : pattern_properties_)
-                    if (std::regex_search(prop.key(), schema_pp.first)) 
+                    if (schema_pp.first.search(prop.key())) 
                     {
                         allowed_properties.insert(prop.key());
                         std::size_t errors = reporter.error_count();
                         schema_pp.second->validate(prop_context, prop.value() , prop_location, results, reporter, patch);
+                        if (reporter.error_count() > errors && !reporter.messages())
+                        {
+                            return;
+                        }
                         if (errors == reporter.error_count())
                         {
                             if (context.require_evaluated_properties())
@@ -2030,11 +2160,12 @@ namespace jsonschema {
             }
 
             std::unordered_set<std::string> allowed_properties;
+            std::size_t errors = reporter.error_count();
 
             if (properties_)
             {
                 properties_->validate(context, instance, instance_location, results, reporter, patch, allowed_properties);
-                if (reporter.fail_early())
+                if (reporter.error_count() > errors && reporter.fail_early())
                 {
                     return;
                 }
@@ -2043,7 +2174,7 @@ namespace jsonschema {
             if (pattern_properties_)
             {
                 pattern_properties_->validate(context, instance, instance_location, results, reporter, patch, allowed_properties);
-                if (reporter.fail_early())
+                if (reporter.error_count() > errors && reporter.fail_early())
                 {
                     return;
                 }
@@ -2057,16 +2188,19 @@ namespace jsonschema {
                     for (const auto& prop : instance.object_range()) 
                     {
                         evaluation_context<Json> prop_context{this_context, prop.key(), evaluation_flags{}};
-                        jsonpointer::json_pointer prop_location = instance_location / prop.key();
+                        jsonpointer::json_pointer prop_location = context.child_location(instance_location, prop.key());
                         // check if it is in "allowed properties"
                         auto properties_it = allowed_properties.find(prop.key());
                         if (properties_it == allowed_properties.end()) 
                         {
-                            reporter.error(validation_message(this->keyword_name(),
-                                prop_context.eval_path(), 
-                                additional_properties_->schema_location(), 
-                                prop_location,
-                                "Additional property '" + prop.key() + "' not allowed by schema."));
+                            reporter.report([&]
+                            {
+                                return validation_message(this->keyword_name(),
+                                    prop_context.eval_path(), 
+                                    additional_properties_->schema_location(), 
+                                    prop_location,
+                                    "Additional property '" + prop.key() + "' not allowed by schema.");
+                            });
                             break;
                         }
                     }
@@ -2090,22 +2224,25 @@ namespace jsonschema {
                         if (properties_it == allowed_properties.end()) 
                         {
                             evaluation_context<Json> prop_context{this_context, prop.key(), evaluation_flags{}};
-                            jsonpointer::json_pointer prop_location = instance_location / prop.key();
+                            jsonpointer::json_pointer prop_location = context.child_location(instance_location, prop.key());
 
                             // finally, check "additionalProperties" 
                             //std::cout << "additional_properties_validator a_prop_or_pattern_matched " << a_prop_or_pattern_matched << ", " << bool(additional_properties_);
                             
                             //std::cout << " !!!additionalProperties!!!";
-                            collecting_error_reporter local_reporter;
+                            collecting_error_reporter local_reporter(reporter.messages());
 
                             additional_properties_->validate(prop_context, prop.value() , prop_location, results, local_reporter, patch);
-                            if (!local_reporter.errors.empty())
+                            if (local_reporter.error_count() > 0)
                             {
-                                reporter.error(validation_message(this->keyword_name(),
-                                    this_context.eval_path(), 
-                                    additional_properties_->schema_location().string(),
-                                    instance_location, 
-                                    "Additional property '" + prop.key() + "' found but was invalid."));
+                                reporter.report([&]
+                                {
+                                    return validation_message(this->keyword_name(),
+                                        this_context.eval_path(), 
+                                        additional_properties_->schema_location().string(),
+                                        instance_location, 
+                                        "Additional property '" + prop.key() + "' found but was invalid.");
+                                });
                                 if (reporter.fail_early())
                                 {
                                     return;
@@ -2161,7 +2298,7 @@ namespace jsonschema {
                 if (prop != instance.object_range().end()) 
                 {
                     // if dependency-prop is present in instance
-                    jsonpointer::json_pointer prop_location = instance_location / dep.first;
+                    jsonpointer::json_pointer prop_location = context.child_location(instance_location, dep.first);
                     dep.second->validate(this_context, instance, prop_location, results, reporter, patch); // validate
                 }
             }
@@ -2206,7 +2343,7 @@ namespace jsonschema {
                 if (prop != instance.object_range().end()) 
                 {
                     // if dependency-prop is present in instance
-                    jsonpointer::json_pointer prop_location = instance_location / dep.first;
+                    jsonpointer::json_pointer prop_location = context.child_location(instance_location, dep.first);
                     dep.second->validate(this_context, instance, prop_location, results, reporter, patch); // validate
                 }
             }
@@ -2249,12 +2386,15 @@ namespace jsonschema {
             {
                 if (schema_val_->always_fails())
                 {
-                    jsonpointer::json_pointer item_location = instance_location / 0;
-                    reporter.error(validation_message(this->keyword_name(),
-                        this_context.eval_path(), 
-                        this->schema_location(), 
-                        item_location,
-                        "Instance has properties but the schema does not allow any property names."));
+                    jsonpointer::json_pointer item_location = context.child_location(instance_location, 0);
+                    reporter.report([&]
+                    {
+                        return validation_message(this->keyword_name(),
+                            this_context.eval_path(), 
+                            this->schema_location(), 
+                            item_location,
+                            "Instance has properties but the schema does not allow any property names.");
+                    });
                     return;
                 }
                 else if (schema_val_->always_succeeds())
@@ -2265,7 +2405,7 @@ namespace jsonschema {
                 {
                     for (const auto& prop : instance.object_range()) 
                     {
-                        jsonpointer::json_pointer prop_location = instance_location / prop.key();
+                        jsonpointer::json_pointer prop_location = context.child_location(instance_location, prop.key());
 
                         schema_val_->validate(this_context, prop.key() , instance_location, results, reporter, patch);
                     }
@@ -2315,7 +2455,7 @@ namespace jsonschema {
                 if (prop != instance.object_range().end()) 
                 {
                     // if dependency-prop is present in instance
-                    jsonpointer::json_pointer prop_location = instance_location / dep.first;
+                    jsonpointer::json_pointer prop_location = context.child_location(instance_location, dep.first);
                     dep.second->validate(this_context, instance, prop_location, results, reporter, patch); // validate
                 }
             }
@@ -2326,7 +2466,7 @@ namespace jsonschema {
                 if (prop != instance.object_range().end()) 
                 {
                     // if dependency-prop is present in instance
-                    jsonpointer::json_pointer prop_location = instance_location / dep.first;
+                    jsonpointer::json_pointer prop_location = context.child_location(instance_location, dep.first);
                     dep.second->validate(this_context, instance, prop_location, results, reporter, patch); // validate
                 }
             }
@@ -2354,13 +2494,16 @@ namespace jsonschema {
 
             if (count > max_value_)
             {
-                std::string message("A schema can match a contains constraint at most " + std::to_string(max_value_) + " times");
-                message.append(" but it matched " + std::to_string(count) + " times.");
-                reporter.error(validation_message(this->keyword_name(),
-                        this_context.eval_path(), 
-                        this->schema_location(),
-                        instance_location, 
-                        std::move(message)));
+                reporter.report([&]
+                {
+                    std::string message("A schema can match a contains constraint at most " + std::to_string(max_value_) + " times");
+                    message.append(" but it matched " + std::to_string(count) + " times.");
+                    return validation_message(this->keyword_name(),
+                            this_context.eval_path(), 
+                            this->schema_location(),
+                            instance_location, 
+                            std::move(message));
+                });
             }
         }
     };
@@ -2388,13 +2531,16 @@ namespace jsonschema {
 
             if (count < min_value_)
             {
-                std::string message("A schema must match a contains constraint at least " + std::to_string(min_value_) + " times");
-                message.append(" but it matched " + std::to_string(count) + " times.");
-                reporter.error(validation_message(this->keyword_name(),
-                        this_context.eval_path(), 
-                        this->schema_location(),
-                        instance_location, 
-                        std::move(message)));
+                reporter.report([&]
+                {
+                    std::string message("A schema must match a contains constraint at least " + std::to_string(min_value_) + " times");
+                    message.append(" but it matched " + std::to_string(count) + " times.");
+                    return validation_message(this->keyword_name(),
+                            this_context.eval_path(), 
+                            this->schema_location(),
+                            instance_location, 
+                            std::move(message));
+                });
             }
         }
     };
@@ -2456,9 +2602,14 @@ namespace jsonschema {
             size_t end = 0;
             for (const auto& item : instance.array_range()) 
             {
-                std::size_t errors = local_reporter.errors.size();
-                schema_validator_->validate(this_context, item, instance_location, results, local_reporter, patch);
-                if (errors == local_reporter.errors.size())
+                // without messages, each item fails early on its own,
+                // unless the results of failing items are needed
+                collecting_error_reporter item_reporter(false);
+                error_reporter& this_reporter = (reporter.messages() || context.require_evaluated_items() || context.require_evaluated_properties())
+                    ? local_reporter : item_reporter;
+                std::size_t errors = this_reporter.error_count();
+                schema_validator_->validate(this_context, item, instance_location, results, this_reporter, patch);
+                if (errors == this_reporter.error_count())
                 {
                     if (context.require_evaluated_items())
                     {
@@ -2469,6 +2620,10 @@ namespace jsonschema {
                         ++end;
                     }
                     ++contains_count;
+                    if (!reporter.messages() && !max_contains_ && !min_contains_ && !context.require_evaluated_items() && !context.require_evaluated_properties())
+                    {
+                        break;
+                    }
                 }
                 else
                 {
@@ -2499,12 +2654,15 @@ namespace jsonschema {
             }
             else if (contains_count == 0)
             {
-                reporter.error(validation_message(this->keyword_name(),
-                    this_context.eval_path(), 
-                    this->schema_location(), 
-                    instance_location, 
-                    "Expected at least one array item to match 'contains' schema.",
-                    local_reporter.errors));
+                reporter.report([&]
+                {
+                    return validation_message(this->keyword_name(),
+                        this_context.eval_path(), 
+                        this->schema_location(), 
+                        instance_location, 
+                        "Expected at least one array item to match 'contains' schema.",
+                        local_reporter.errors);
+                });
                 if (reporter.fail_early())
                 {
                     return;
@@ -2556,9 +2714,13 @@ namespace jsonschema {
             {
                 auto& val = prefix_item_validators_[schema_index];
                 evaluation_context<Json> item_context{prefix_items_context, schema_index, evaluation_flags{}};
-                jsonpointer::json_pointer item_location = instance_location / data_index;
+                jsonpointer::json_pointer item_location = context.child_location(instance_location, data_index);
                 std::size_t errors = reporter.error_count();
                 val->validate(item_context, instance[data_index], item_location, results, reporter, patch);
+                if (reporter.error_count() > errors && !reporter.messages())
+                {
+                    return;
+                }
                 if (errors == reporter.error_count())
                 {
                     if (context.require_evaluated_items())
@@ -2590,12 +2752,15 @@ namespace jsonschema {
                 evaluation_context<Json> items_context(context, "items");
                 if (items_val_->always_fails())
                 {
-                    jsonpointer::json_pointer item_location = instance_location / data_index;
-                    reporter.error(validation_message(this->keyword_name(),
-                        items_context.eval_path(), 
-                        this->schema_location(), 
-                        item_location,
-                        "Extra item at index '" + std::to_string(data_index) + "' but the schema does not allow extra items."));
+                    jsonpointer::json_pointer item_location = context.child_location(instance_location, data_index);
+                    reporter.report([&]
+                    {
+                        return validation_message(this->keyword_name(),
+                            items_context.eval_path(), 
+                            this->schema_location(), 
+                            item_location,
+                            "Extra item at index '" + std::to_string(data_index) + "' but the schema does not allow extra items.");
+                    });
                     if (reporter.fail_early())
                     {
                         return;
@@ -2613,9 +2778,13 @@ namespace jsonschema {
                     {
                         if (items_val_)
                         {
-                            jsonpointer::json_pointer item_location = instance_location / data_index;
+                            jsonpointer::json_pointer item_location = context.child_location(instance_location, data_index);
                             std::size_t errors = reporter.error_count();
                             items_val_->validate(items_context, instance[data_index], item_location, results, reporter, patch);
+                            if (reporter.error_count() > errors && !reporter.messages())
+                            {
+                                return;
+                            }
                             if (errors == reporter.error_count())
                             {
                                 if (context.require_evaluated_items())
@@ -2695,13 +2864,16 @@ namespace jsonschema {
                         if (prop_it == results.evaluated_properties.end()) 
                         {
                             evaluation_context<Json> prop_context{this_context, prop.key(), evaluation_flags{}};
-                            jsonpointer::json_pointer prop_location = instance_location / prop.key();
+                            jsonpointer::json_pointer prop_location = context.child_location(instance_location, prop.key());
 
-                            reporter.error(validation_message(this->keyword_name(),
-                                prop_context.eval_path(), 
-                                this->schema_location(), 
-                                prop_location,
-                                "Unevaluated property '" + prop.key() + "' but the schema does not allow unevaluated properties."));
+                            reporter.report([&]
+                            {
+                                return validation_message(this->keyword_name(),
+                                    prop_context.eval_path(), 
+                                    this->schema_location(), 
+                                    prop_location,
+                                    "Unevaluated property '" + prop.key() + "' but the schema does not allow unevaluated properties.");
+                            });
                             break;
                         }
                     }
@@ -2727,6 +2899,10 @@ namespace jsonschema {
                             //std::cout << "Not in evaluated properties: " << prop.key() << "\n";
                             std::size_t error_count = reporter.error_count();
                             schema_val_->validate(this_context, prop.value() , instance_location, results, reporter, patch);
+                            if (reporter.error_count() > error_count && !reporter.messages())
+                            {
+                                return;
+                            }
                             if (reporter.error_count() == error_count)
                             {
                                 if (context.require_evaluated_properties())
@@ -2789,13 +2965,16 @@ namespace jsonschema {
                         if (!results.evaluated_items.contains(index)) 
                         {
                             evaluation_context<Json> item_context{this_context, index, evaluation_flags{}};
-                            jsonpointer::json_pointer item_location = instance_location / index;
+                            jsonpointer::json_pointer item_location = context.child_location(instance_location, index);
                             //std::cout << "Not in evaluated properties: " << item.key() << "\n";
-                            reporter.error(validation_message(this->keyword_name(),
-                                item_context.eval_path(), 
-                                this->schema_location(), 
-                                item_location,
-                                "Unevaluated item at index '" + std::to_string(index) + "' but the schema does not allow unevaluated items."));
+                            reporter.report([&]
+                            {
+                                return validation_message(this->keyword_name(),
+                                    item_context.eval_path(), 
+                                    this->schema_location(), 
+                                    item_location,
+                                    "Unevaluated item at index '" + std::to_string(index) + "' but the schema does not allow unevaluated items.");
+                            });
                             break;
                         }
                     }
@@ -2818,10 +2997,14 @@ namespace jsonschema {
                         if (!results.evaluated_items.contains(index))
                         {
                             evaluation_context<Json> item_context{this_context, index, evaluation_flags{}};
-                            jsonpointer::json_pointer item_location = instance_location / index;
+                            jsonpointer::json_pointer item_location = context.child_location(instance_location, index);
                             //std::cout << "Not in evaluated properties: " << item.key() << "\n";
                             std::size_t error_count = reporter.error_count();
                             schema_val_->validate(item_context, item, item_location, results, reporter, patch);
+                            if (reporter.error_count() > error_count && !reporter.messages())
+                            {
+                                return;
+                            }
                             if (reporter.error_count() == error_count)
                             {
                                 if (context.require_evaluated_items())
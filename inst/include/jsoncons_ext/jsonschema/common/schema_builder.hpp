@@ -44,6 +44,9 @@ namespace jsonschema {
         
         // Owns external schemas
         std::vector<schema_validator_type> schemas_;
+
+        // Compiled "pattern" and "patternProperties" regexes, by pattern
+        std::unordered_map<std::string,schema_regex> regexes_;
     public:
         std::vector<std::pair<jsoncons::uri, ref_type*>> unresolved_refs_; 
         std::map<jsoncons::uri, Json> unknown_keywords_;
@@ -72,6 +75,17 @@ namespace jsonschema {
         virtual ~schema_builder() = default;
 
         const std::unordered_map<std::string,bool>& vocabulary() const {return vocabulary_;}
+
+        // Patterns repeated in a schema are compiled once, and shared
+        schema_regex make_regex(const std::string& pattern)
+        {
+            auto it = regexes_.find(pattern);
+            if (it == regexes_.end())
+            {
+                it = regexes_.emplace(pattern, schema_regex(pattern)).first;
+            }
+            return it->second;
+        }
         
         void save_schema(schema_validator_type&& schema)
         {
@@ -653,7 +667,7 @@ namespace jsonschema {
         {
             uri schema_location = context.make_schema_path_with("pattern");
             auto pattern_string = sch.template as<std::string>();
-            auto regex = std::regex(pattern_string, std::regex::ECMAScript);
+            auto regex = make_regex(pattern_string);
             return jsoncons::make_unique<pattern_validator<Json>>( schema_location, 
                 pattern_string, regex);
         }
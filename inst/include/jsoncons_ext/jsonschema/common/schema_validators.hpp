@@ -162,11 +162,14 @@ namespace jsonschema {
         {
             if (!value_)
             {
-                reporter.error(validation_message("false", 
-                    context.eval_path(),
-                    this->schema_location(), 
-                    instance_location, 
-                    "False schema always fails"));
+                reporter.report([&]
+                {
+                    return validation_message("false", 
+                        context.eval_path(),
+                        this->schema_location(), 
+                        instance_location, 
+                        "False schema always fails");
+                });
             }
         }
     };
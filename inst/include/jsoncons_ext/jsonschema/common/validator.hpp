@@ -23,9 +23,17 @@ namespace jsonschema {
     {
         bool fail_early_;
         std::size_t error_count_;
+        bool messages_;
     public:
         error_reporter(bool fail_early = false)
-            : fail_early_(fail_early), error_count_(0)
+            : fail_early_(fail_early), error_count_(0), messages_(true)
+        {
+        }
+
+        // Without messages, only whether there are errors is needed, so
+        // validation also fails early
+        error_reporter(bool fail_early, bool messages)
+            : fail_early_(fail_early || !messages), error_count_(0), messages_(messages)
         {
         }
 
@@ -37,6 +45,27 @@ namespace jsonschema {
             do_error(o);
         }
 
+        // Reports an error whose message is built by make_message();
+        // when messages() is false, the error is only counted and
+        // make_message() is not called
+        template <class MakeMessage>
+        void report(MakeMessage make_message)
+        {
+            if (messages_)
+            {
+                error(make_message());
+            }
+            else
+            {
+                ++error_count_;
+            }
+        }
+
+        bool messages() const
+        {
+            return messages_;
+        }
+
         std::size_t error_count() const
         {
             return error_count_;
@@ -56,6 +85,16 @@ namespace jsonschema {
     {
         std::vector<validation_message> errors;
 
+        collecting_error_reporter()
+        {
+        }
+
+        // Without messages, collects nothing and fails early
+        explicit collecting_error_reporter(bool messages)
+            : error_reporter(false, messages)
+        {
+        }
+
     private:
         void do_error(const validation_message& o) final
         {
@@ -315,11 +354,14 @@ namespace jsonschema {
 
             if (!referred_schema_)
             {
-                reporter.error(validation_message(this->keyword_name(), 
-                    this_context.eval_path(),
-                    this->schema_location(), 
-                    instance_location, 
-                    "Unresolved schema reference " + this->schema_location().string()));
+                reporter.report([&]
+                {
+                    return validation_message(this->keyword_name(), 
+                        this_context.eval_path(),
+                        this->schema_location(), 
+                        instance_location, 
+                        "Unresolved schema reference " + this->schema_location().string());
+                });
                 return;
             }
 
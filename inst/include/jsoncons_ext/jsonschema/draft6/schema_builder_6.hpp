@@ -292,14 +292,14 @@ namespace draft6 {
             const Json& sch, anchor_uri_map_type& anchor_dict)
         {
             uri schema_location = context.get_base_uri();
-            std::vector<std::pair<std::regex, schema_validator_type>> pattern_properties;
+            std::vector<std::pair<schema_regex, schema_validator_type>> pattern_properties;
             
             for (const auto& prop : sch.object_range())
             {
                 std::string sub_keys[] = {prop.key()};
                 pattern_properties.emplace_back(
                     std::make_pair(
-                        std::regex(prop.key(), std::regex::ECMAScript),
+                        this->make_regex(prop.key()),
                         make_schema_validator(context, prop.value(), sub_keys, anchor_dict)));
             }
 
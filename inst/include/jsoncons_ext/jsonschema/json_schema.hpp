@@ -36,6 +36,20 @@ namespace jsonschema {
         }
     };
 
+    // Stops at the first error, without constructing messages or
+    // evaluation paths; for is_valid()
+    class boolean_reporter : public error_reporter
+    {
+        void do_error(const validation_message&) override
+        {
+        }
+    public:
+        boolean_reporter()
+            : error_reporter(true, false)
+        {
+        }
+    };
+
     using error_reporter_t = std::function<void(const validation_message& o)>;
 
     struct error_reporter_adaptor : public error_reporter
@@ -94,11 +108,11 @@ namespace jsonschema {
         // Validate input JSON against a JSON Schema 
         bool is_valid(const Json& instance) const
         {
-            fail_early_reporter reporter;
+            boolean_reporter reporter;
             jsonpointer::json_pointer instance_location{};
             Json patch(json_array_arg);
 
-            evaluation_context<Json> context;
+            evaluation_context<Json> context(reporter.messages());
             evaluation_results results;
             root_->validate(context, instance, instance_location, results, reporter, patch);
             return reporter.error_count() == 0;
@@ -167,7 +181,7 @@ namespace jsonschema {
             jsonpointer::json_pointer instance_location{};
             patch = Json(json_array_arg);
 
-            evaluation_context<Json> context;
+            evaluation_context<Json> context(reporter.messages());
             evaluation_results results;
             root_->validate(context, instance, instance_location, results, reporter, patch);
         }
@@ -145,7 +145,7 @@ class validation_output
         // Validate input JSON against a JSON Schema 
         bool is_valid(const Json& instance) const
         {
-            fail_early_reporter reporter;
+            boolean_reporter reporter;
             Json patch(json_array_arg);
 
             root_->validate2(instance, reporter, patch);
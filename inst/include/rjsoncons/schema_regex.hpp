@@ -0,0 +1,1146 @@
+// Part of the rjsoncons R package, distributed under the Boost
+// Software License, Version 1.0, as for the package. This is not part
+// of the jsoncons library; the jsoncons headers in this directory are
+// patched to use it (see inst/include/README.md).
+
+#ifndef RJSONCONS_SCHEMA_REGEX_HPP
+#define RJSONCONS_SCHEMA_REGEX_HPP
+
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons_ext/jsonschema/jsonschema_error.hpp>
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <map>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#if defined(JSONCONS_HAS_STD_REGEX)
+#include <regex>
+#endif
+
+namespace rjsoncons {
+
+    // Regular expressions for "pattern", "patternProperties" and the
+    // "regex" format. Patterns are compiled to a Thompson NFA over
+    // Unicode code points, and searched in time linear in the length
+    // of the subject, without recursion. Patterns using features that
+    // need backtracking (backreferences, lookaround), or that are not
+    // recognized, are compiled with std::regex instead.
+    //
+    // Copies share the compiled pattern; search() is const and may be
+    // called concurrently.
+
+    class schema_regex
+    {
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+        static constexpr uint32_t max_code_point = 0x10FFFF;
+        // limits on counted repetition and program size
+        static constexpr std::size_t max_repeat = 1000;
+        static constexpr std::size_t max_program_size = 100000;
+        // limits on building a DFA
+        static constexpr std::size_t max_dfa_program_size = 2000;
+        static constexpr std::size_t max_dfa_states = 256;
+
+        enum class op_code {character, any, char_class, split, jump,
+            assert_begin, assert_end, word_boundary, not_word_boundary, match};
+
+        struct instruction
+        {
+            op_code op;
+            uint32_t value; // character, or index of char_class
+            std::size_t x;  // split, jump
+            std::size_t y;  // split
+        };
+
+        struct char_class
+        {
+            std::vector<std::pair<uint32_t,uint32_t>> ranges;
+            std::bitset<128> ascii;
+            bool negated = false;
+
+            bool contains(uint32_t c) const
+            {
+                bool found;
+                if (c < 128)
+                {
+                    found = ascii[c];
+                }
+                else
+                {
+                    auto it = std::upper_bound(ranges.begin(), ranges.end(),
+                        std::make_pair(c, uint32_t(max_code_point)));
+                    found = it != ranges.begin() && (it - 1)->second >= c;
+                }
+                return found != negated;
+            }
+
+            // sort and merge ranges, and index ASCII members
+            void finish()
+            {
+                std::sort(ranges.begin(), ranges.end());
+                std::vector<std::pair<uint32_t,uint32_t>> merged;
+                for (const auto& range : ranges)
+                {
+                    if (!merged.empty() && range.first <= merged.back().second + 1)
+                    {
+                        merged.back().second = (std::max)(merged.back().second, range.second);
+                    }
+                    else
+                    {
+                        merged.push_back(range);
+                    }
+                }
+                ranges = std::move(merged);
+                for (const auto& range : ranges)
+                {
+                    for (uint32_t c = range.first; c <= range.second && c < 128; ++c)
+                    {
+                        ascii[c] = true;
+                    }
+                }
+            }
+        };
+
+        enum class node_kind {character, any, char_class, assertion, concat, alternate, repeat};
+
+        struct node
+        {
+            node_kind kind;
+            uint32_t value = 0;     // character, class index, or op_code of assertion
+            std::size_t min = 0;    // repeat
+            std::size_t max = 0;    // repeat; npos if unbounded
+            std::vector<std::unique_ptr<node>> children;
+
+            explicit node(node_kind k, uint32_t v = 0)
+                : kind(k), value(v)
+            {
+            }
+        };
+
+        // thrown by the parser for patterns left to std::regex
+        struct unsupported_pattern {};
+
+        // deterministic automaton over ASCII subjects, built from the
+        // NFA when the NFA has no word boundaries and is small. State 0
+        // is the start; a transition of -1 cannot match.
+        struct dfa
+        {
+            std::array<uint16_t,128> byte_class;
+            std::size_t n_classes = 0;
+            std::vector<int> transitions;  // state * n_classes + class
+            std::vector<char> match_here;  // match before the next character
+            std::vector<char> match_end;   // match at the end of the subject
+        };
+
+        struct program
+        {
+            std::vector<instruction> instructions;
+            std::vector<char_class> classes;
+            bool anchored = false;
+            // when 'skip', a match can only start at an ASCII
+            // character in 'first', or at any non-ASCII character if
+            // 'first_non_ascii'
+            bool skip = false;
+            std::bitset<128> first;
+            bool first_non_ascii = false;
+            bool has_dfa = false;
+            dfa automaton;
+        };
+
+        // per-thread buffers for search()
+        struct scratch
+        {
+            std::vector<std::size_t> current;
+            std::vector<std::size_t> next;
+            std::vector<std::size_t> stack;
+            std::vector<std::size_t> added;
+            std::size_t generation = 0;
+        };
+
+        class parser
+        {
+            const std::vector<uint32_t>& pattern_;
+            std::size_t pos_ = 0;
+            std::vector<char_class>& classes_;
+        public:
+            parser(const std::vector<uint32_t>& pattern, std::vector<char_class>& classes)
+                : pattern_(pattern), classes_(classes)
+            {
+            }
+
+            std::unique_ptr<node> parse()
+            {
+                auto result = parse_alternation();
+                if (pos_ != pattern_.size())
+                {
+                    throw unsupported_pattern(); // unbalanced ')'
+                }
+                return result;
+            }
+
+        private:
+            bool at_end() const {return pos_ == pattern_.size();}
+
+            uint32_t peek() const {return pattern_[pos_];}
+
+            uint32_t next()
+            {
+                if (at_end())
+                {
+                    throw unsupported_pattern();
+                }
+                return pattern_[pos_++];
+            }
+
+            std::unique_ptr<node> parse_alternation()
+            {
+                auto first = parse_concat();
+                if (at_end() || peek() != '|')
+                {
+                    return first;
+                }
+                std::unique_ptr<node> result(new node(node_kind::alternate));
+                result->children.push_back(std::move(first));
+                while (!at_end() && peek() == '|')
+                {
+                    ++pos_;
+                    result->children.push_back(parse_concat());
+                }
+                return result;
+            }
+
+            std::unique_ptr<node> parse_concat()
+            {
+                std::unique_ptr<node> result(new node(node_kind::concat));
+                while (!at_end() && peek() != '|' && peek() != ')')
+                {
+                    result->children.push_back(parse_repeat());
+                }
+                return result;
+            }
+
+            std::unique_ptr<node> parse_repeat()
+            {
+                auto atom = parse_atom();
+                if (at_end())
+                {
+                    return atom;
+                }
+                std::size_t min = 0, max = npos;
+                switch (peek())
+                {
+                    case '*':
+                        ++pos_;
+                        break;
+                    case '+':
+                        ++pos_;
+                        min = 1;
+                        break;
+                    case '?':
+                        ++pos_;
+                        max = 1;
+                        break;
+                    case '{':
+                        ++pos_;
+                        min = parse_count();
+                        max = min;
+                        if (!at_end() && peek() == ',')
+                        {
+                            ++pos_;
+                            max = !at_end() && peek() == '}' ? npos : parse_count();
+                        }
+                        if (next() != '}' || max < min)
+                        {
+                            throw unsupported_pattern();
+                        }
+                        break;
+                    default:
+                        return atom;
+                }
+                if (atom->kind == node_kind::assertion)
+                {
+                    throw unsupported_pattern();
+                }
+                // lazy and greedy quantifiers match the same strings
+                if (!at_end() && peek() == '?')
+                {
+                    ++pos_;
+                }
+                std::unique_ptr<node> result(new node(node_kind::repeat));
+                result->min = min;
+                result->max = max;
+                result->children.push_back(std::move(atom));
+                return result;
+            }
+
+            std::size_t parse_count()
+            {
+                std::size_t count = 0;
+                std::size_t n_digits = 0;
+                while (!at_end() && peek() >= '0' && peek() <= '9')
+                {
+                    count = count * 10 + (next() - '0');
+                    if (count > max_repeat)
+                    {
+                        throw unsupported_pattern();
+                    }
+                    ++n_digits;
+                }
+                if (n_digits == 0)
+                {
+                    throw unsupported_pattern();
+                }
+                return count;
+            }
+
+            std::unique_ptr<node> parse_atom()
+            {
+                uint32_t c = next();
+                switch (c)
+                {
+                    case '(':
+                    {
+                        if (!at_end() && peek() == '?')
+                        {
+                            // only non-capturing groups; no lookaround
+                            ++pos_;
+                            if (next() != ':')
+                            {
+                                throw unsupported_pattern();
+                            }
+                        }
+                        auto result = parse_alternation();
+                        if (next() != ')')
+                        {
+                            throw unsupported_pattern();
+                        }
+                        return result;
+                    }
+                    case '[':
+                        return std::unique_ptr<node>(new node(node_kind::char_class, parse_class()));
+                    case '.':
+                        return std::unique_ptr<node>(new node(node_kind::any));
+                    case '^':
+                        return std::unique_ptr<node>(new node(node_kind::assertion,
+                            static_cast<uint32_t>(op_code::assert_begin)));
+                    case '$':
+                        return std::unique_ptr<node>(new node(node_kind::assertion,
+                            static_cast<uint32_t>(op_code::assert_end)));
+                    case '\\':
+                        return parse_escape();
+                    case '*': case '+': case '?': case '{': case '}': case ']': case ')':
+                        throw unsupported_pattern();
+                    default:
+                        return std::unique_ptr<node>(new node(node_kind::character, c));
+                }
+            }
+
+            std::unique_ptr<node> parse_escape()
+            {
+                uint32_t c = next();
+                switch (c)
+                {
+                    case 'b':
+                        return std::unique_ptr<node>(new node(node_kind::assertion,
+                            static_cast<uint32_t>(op_code::word_boundary)));
+                    case 'B':
+                        return std::unique_ptr<node>(new node(node_kind::assertion,
+                            static_cast<uint32_t>(op_code::not_word_boundary)));
+                    case 'd': case 'D': case 'w': case 'W': case 's': case 'S':
+                    {
+                        char_class cls;
+                        add_class_escape(cls, c);
+                        cls.finish();
+                        classes_.push_back(std::move(cls));
+                        return std::unique_ptr<node>(new node(node_kind::char_class,
+                            static_cast<uint32_t>(classes_.size() - 1)));
+                    }
+                    default:
+                        return std::unique_ptr<node>(new node(node_kind::character, parse_character_escape(c)));
+                }
+            }
+
+            // escapes denoting a single character, after the '\\'
+            uint32_t parse_character_escape(uint32_t c)
+            {
+                switch (c)
+                {
+                    case 't': return '\t';
+                    case 'n': return '\n';
+                    case 'v': return '\v';
+                    case 'f': return '\f';
+                    case 'r': return '\r';
+                    case '0':
+                        if (!at_end() && peek() >= '0' && peek() <= '9')
+                        {
+                            throw unsupported_pattern(); // octal
+                        }
+                        return 0;
+                    case 'c':
+                    {
+                        uint32_t letter = next();
+                        if (!((letter >= 'a' && letter <= 'z') || (letter >= 'A' && letter <= 'Z')))
+                        {
+                            throw unsupported_pattern();
+                        }
+                        return letter % 32;
+                    }
+                    case 'x':
+                        return parse_hex(2);
+                    case 'u':
+                    {
+                        uint32_t cp = parse_hex(4);
+                        // surrogate pair
+                        if (cp >= 0xD800 && cp <= 0xDBFF && pos_ + 5 < pattern_.size() &&
+                            pattern_[pos_] == '\\' && pattern_[pos_ + 1] == 'u')
+                        {
+                            std::size_t start = pos_;
+                            pos_ += 2;
+                            uint32_t low = parse_hex(4);
+                            if (low >= 0xDC00 && low <= 0xDFFF)
+                            {
+                                return 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                            }
+                            pos_ = start;
+                        }
+                        return cp;
+                    }
+                    default:
+                        // identity escapes, e.g., '\.'; other letters
+                        // and digits (backreferences, '\p', ...) are
+                        // left to std::regex
+                        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))
+                        {
+                            throw unsupported_pattern();
+                        }
+                        return c;
+                }
+            }
+
+            uint32_t parse_hex(std::size_t n)
+            {
+                uint32_t value = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    uint32_t c = next();
+                    uint32_t digit;
+                    if (c >= '0' && c <= '9')
+                    {
+                        digit = c - '0';
+                    }
+                    else if (c >= 'a' && c <= 'f')
+                    {
+                        digit = c - 'a' + 10;
+                    }
+                    else if (c >= 'A' && c <= 'F')
+                    {
+                        digit = c - 'A' + 10;
+                    }
+                    else
+                    {
+                        throw unsupported_pattern();
+                    }
+                    value = value * 16 + digit;
+                }
+                return value;
+            }
+
+            // after '['; returns the index of the class
+            uint32_t parse_class()
+            {
+                char_class cls;
+                if (!at_end() && peek() == '^')
+                {
+                    ++pos_;
+                    cls.negated = true;
+                }
+                if (!at_end() && peek() == ']')
+                {
+                    throw unsupported_pattern(); // '[]' and '[^]'
+                }
+                while (next_is_not(']'))
+                {
+                    uint32_t lo;
+                    const bool is_character = parse_class_atom(cls, lo);
+                    const bool is_range = pos_ + 1 < pattern_.size() &&
+                        peek() == '-' && pattern_[pos_ + 1] != ']';
+                    if (!is_character)
+                    {
+                        if (is_range)
+                        {
+                            throw unsupported_pattern(); // e.g., '[\d-z]'
+                        }
+                        continue;
+                    }
+                    if (is_range)
+                    {
+                        ++pos_;
+                        uint32_t hi;
+                        if (!parse_class_atom(cls, hi) || hi < lo)
+                        {
+                            throw unsupported_pattern();
+                        }
+                        cls.ranges.emplace_back(lo, hi);
+                    }
+                    else
+                    {
+                        cls.ranges.emplace_back(lo, lo);
+                    }
+                }
+                cls.finish();
+                classes_.push_back(std::move(cls));
+                return static_cast<uint32_t>(classes_.size() - 1);
+            }
+
+            bool next_is_not(uint32_t c)
+            {
+                if (at_end())
+                {
+                    throw unsupported_pattern(); // unterminated class
+                }
+                if (peek() == c)
+                {
+                    ++pos_;
+                    return false;
+                }
+                return true;
+            }
+
+            // a character (returned in 'c'), or a class escape added
+            // directly to 'cls' (returns false)
+            bool parse_class_atom(char_class& cls, uint32_t& c)
+            {
+                c = next();
+                if (c != '\\')
+                {
+                    return true;
+                }
+                c = next();
+                switch (c)
+                {
+                    case 'b':
+                        c = '\b';
+                        return true;
+                    case '-':
+                        return true;
+                    case 'd': case 'D': case 'w': case 'W': case 's': case 'S':
+                        add_class_escape(cls, c);
+                        return false;
+                    default:
+                        c = parse_character_escape(c);
+                        return true;
+                }
+            }
+
+            static void add_class_escape(char_class& cls, uint32_t escape)
+            {
+                static const std::vector<std::pair<uint32_t,uint32_t>> digit = {{'0', '9'}};
+                static const std::vector<std::pair<uint32_t,uint32_t>> word =
+                    {{'0', '9'}, {'A', 'Z'}, {'_', '_'}, {'a', 'z'}};
+                static const std::vector<std::pair<uint32_t,uint32_t>> space =
+                    {{'\t', '\r'}, {' ', ' '}, {0xA0, 0xA0}, {0x1680, 0x1680},
+                     {0x2000, 0x200A}, {0x2028, 0x2029}, {0x202F, 0x202F},
+                     {0x205F, 0x205F}, {0x3000, 0x3000}, {0xFEFF, 0xFEFF}};
+
+                const std::vector<std::pair<uint32_t,uint32_t>>* ranges;
+                switch (escape)
+                {
+                    case 'd': case 'D':
+                        ranges = &digit;
+                        break;
+                    case 'w': case 'W':
+                        ranges = &word;
+                        break;
+                    default:
+                        ranges = &space;
+                        break;
+                }
+                if (escape == 'd' || escape == 'w' || escape == 's')
+                {
+                    cls.ranges.insert(cls.ranges.end(), ranges->begin(), ranges->end());
+                    return;
+                }
+                // complement of sorted, disjoint ranges
+                uint32_t lo = 0;
+                for (const auto& range : *ranges)
+                {
+                    if (range.first > lo)
+                    {
+                        cls.ranges.emplace_back(lo, range.first - 1);
+                    }
+                    lo = range.second + 1;
+                }
+                cls.ranges.emplace_back(lo, uint32_t(max_code_point));
+            }
+        };
+
+        std::shared_ptr<const program> program_;
+#if defined(JSONCONS_HAS_STD_REGEX)
+        std::shared_ptr<const std::regex> std_regex_;
+#endif
+
+    public:
+        explicit schema_regex(const std::string& pattern)
+        {
+            std::shared_ptr<program> prog = std::make_shared<program>();
+            bool linear = true;
+            try
+            {
+                auto code_points = decode(pattern);
+                parser p(code_points, prog->classes);
+                auto tree = p.parse();
+                emit(*prog, *tree);
+                prog->instructions.push_back(instruction{op_code::match, 0, 0, 0});
+                prog->anchored = prog->instructions.front().op == op_code::assert_begin;
+                find_first(*prog);
+                build_dfa(*prog);
+            }
+            catch (const unsupported_pattern&)
+            {
+                linear = false;
+            }
+
+            if (linear)
+            {
+                program_ = std::move(prog);
+                return;
+            }
+#if defined(JSONCONS_HAS_STD_REGEX)
+            std_regex_ = std::make_shared<const std::regex>(pattern, std::regex::ECMAScript);
+#else
+            JSONCONS_THROW(jsoncons::jsonschema::schema_error("'" + pattern + "' is not a supported regular expression"));
+#endif
+        }
+
+        // true if the pattern matches anywhere in 's'
+        bool search(const std::string& s) const
+        {
+#if defined(JSONCONS_HAS_STD_REGEX)
+            if (std_regex_)
+            {
+                return std::regex_search(s, *std_regex_);
+            }
+#endif
+            const program& prog = *program_;
+            if (prog.has_dfa)
+            {
+                const dfa& automaton = prog.automaton;
+                int state = 0;
+                std::size_t i = 0;
+                for (; i < s.size(); ++i)
+                {
+                    const unsigned char b = static_cast<unsigned char>(s[i]);
+                    if (b >= 128)
+                    {
+                        break; // not ASCII; use the NFA
+                    }
+                    if (automaton.match_here[state])
+                    {
+                        return true;
+                    }
+                    state = automaton.transitions[state * automaton.n_classes + automaton.byte_class[b]];
+                    if (state < 0)
+                    {
+                        return false;
+                    }
+                }
+                if (i == s.size())
+                {
+                    return automaton.match_end[state] != 0;
+                }
+            }
+
+            const std::size_t n = prog.instructions.size();
+            scratch& buffers = thread_scratch();
+            std::vector<std::size_t>& current = buffers.current;
+            std::vector<std::size_t>& next = buffers.next;
+            std::vector<std::size_t>& stack = buffers.stack;
+            // generation in which each instruction was last added;
+            // generations increase across calls, so are never stale
+            std::vector<std::size_t>& added = buffers.added;
+            if (added.size() < n)
+            {
+                added.resize(n, 0);
+            }
+            std::size_t& generation = buffers.generation;
+            ++generation;
+            current.clear();
+
+            std::size_t pos = 0;
+            uint32_t prev = 0;
+            bool has_prev = false;
+            std::size_t next_pos = 0;
+            bool has_c = pos < s.size();
+            uint32_t c = has_c ? decode_one(s, next_pos) : 0;
+            while (true)
+            {
+                if (prog.skip && current.empty())
+                {
+                    // advance to a character that can start a match
+                    while (pos < s.size() && !can_start(prog, static_cast<unsigned char>(s[pos])))
+                    {
+                        ++pos;
+                    }
+                    if (pos == s.size())
+                    {
+                        return false;
+                    }
+                    next_pos = pos;
+                    c = decode_one(s, next_pos);
+                    has_c = true;
+                }
+
+                // unanchored: a new thread starts at each position
+                if (!prog.anchored || pos == 0)
+                {
+                    if (add_thread(prog, 0, current, added, generation, stack, has_prev, prev, has_c, c))
+                    {
+                        return true;
+                    }
+                }
+                if (!has_c || (prog.anchored && current.empty()))
+                {
+                    return false;
+                }
+
+                // step over 'c'
+                std::size_t after_pos = next_pos;
+                bool has_after = after_pos < s.size();
+                uint32_t after = has_after ? decode_one(s, after_pos) : 0;
+                ++generation;
+                next.clear();
+                for (std::size_t pc : current)
+                {
+                    if (consumes(prog, prog.instructions[pc], c) &&
+                        add_thread(prog, pc + 1, next, added, generation, stack, true, c, has_after, after))
+                    {
+                        return true;
+                    }
+                }
+                std::swap(current, next);
+
+                pos = next_pos;
+                next_pos = after_pos;
+                prev = c;
+                has_prev = true;
+                has_c = has_after;
+                c = after;
+            }
+        }
+
+    private:
+        static scratch& thread_scratch()
+        {
+            thread_local scratch buffers;
+            return buffers;
+        }
+
+        static bool can_start(const program& prog, unsigned char b)
+        {
+            return b < 128 ? prog.first[b] : prog.first_non_ascii;
+        }
+
+        // characters that can start a match; no skipping if a match
+        // can start with an assertion, or be empty
+        static void find_first(program& prog)
+        {
+            std::vector<bool> seen(prog.instructions.size(), false);
+            std::vector<std::size_t> stack = {0};
+            while (!stack.empty())
+            {
+                std::size_t pc = stack.back();
+                stack.pop_back();
+                if (seen[pc])
+                {
+                    continue;
+                }
+                seen[pc] = true;
+                const instruction& inst = prog.instructions[pc];
+                switch (inst.op)
+                {
+                    case op_code::jump:
+                        stack.push_back(inst.x);
+                        break;
+                    case op_code::split:
+                        stack.push_back(inst.y);
+                        stack.push_back(inst.x);
+                        break;
+                    case op_code::character:
+                        if (inst.value < 128)
+                        {
+                            prog.first[inst.value] = true;
+                        }
+                        else
+                        {
+                            prog.first_non_ascii = true;
+                        }
+                        break;
+                    case op_code::char_class:
+                    {
+                        const char_class& cls = prog.classes[inst.value];
+                        for (uint32_t b = 0; b < 128; ++b)
+                        {
+                            if (cls.contains(b))
+                            {
+                                prog.first[b] = true;
+                            }
+                        }
+                        if (cls.negated || (!cls.ranges.empty() && cls.ranges.back().second >= 128))
+                        {
+                            prog.first_non_ascii = true;
+                        }
+                        break;
+                    }
+                    default:
+                        // any, assertions, match
+                        return;
+                }
+            }
+            prog.skip = true;
+        }
+
+        static void build_dfa(program& prog)
+        {
+            const auto& code = prog.instructions;
+            if (code.size() > max_dfa_program_size)
+            {
+                return;
+            }
+            // '^' only at the start, so states need not know whether
+            // a character precedes them
+            for (std::size_t pc = 0; pc < code.size(); ++pc)
+            {
+                const op_code op = code[pc].op;
+                if (op == op_code::word_boundary || op == op_code::not_word_boundary ||
+                    (op == op_code::assert_begin && pc != 0))
+                {
+                    return;
+                }
+            }
+
+            dfa automaton;
+            // bytes consumed by the same instructions share a class
+            std::map<std::vector<bool>, uint16_t> signatures;
+            std::vector<uint32_t> representatives;
+            for (uint32_t b = 0; b < 128; ++b)
+            {
+                std::vector<bool> signature(code.size());
+                for (std::size_t pc = 0; pc < code.size(); ++pc)
+                {
+                    signature[pc] = consumes(prog, code[pc], b);
+                }
+                auto result = signatures.emplace(std::move(signature),
+                    static_cast<uint16_t>(representatives.size()));
+                if (result.second)
+                {
+                    representatives.push_back(b);
+                }
+                automaton.byte_class[b] = result.first->second;
+            }
+            automaton.n_classes = representatives.size();
+
+            // states are identified by the instructions that start
+            // them, before following jumps, splits and assertions
+            std::map<std::vector<std::size_t>, int> ids;
+            std::vector<std::vector<std::size_t>> states = {{0}};
+            ids.emplace(states.front(), 0);
+            std::vector<std::size_t> list, stack;
+            std::vector<std::size_t> added(code.size(), 0);
+            std::size_t generation = 0;
+            for (std::size_t id = 0; id < states.size(); ++id)
+            {
+                const bool has_prev = id != 0;
+                bool match_end = false;
+                ++generation;
+                list.clear();
+                for (std::size_t pc : states[id])
+                {
+                    match_end = add_thread(prog, pc, list, added, generation, stack, has_prev, 0, false, 0) || match_end;
+                }
+                bool match_here = false;
+                ++generation;
+                list.clear();
+                for (std::size_t pc : states[id])
+                {
+                    match_here = add_thread(prog, pc, list, added, generation, stack, has_prev, 0, true, 0) || match_here;
+                }
+                automaton.match_end.push_back(match_end);
+                automaton.match_here.push_back(match_here);
+
+                for (uint32_t b : representatives)
+                {
+                    std::vector<std::size_t> seeds;
+                    for (std::size_t pc : list)
+                    {
+                        if (consumes(prog, code[pc], b))
+                        {
+                            seeds.push_back(pc + 1);
+                        }
+                    }
+                    if (!prog.anchored)
+                    {
+                        seeds.push_back(0);
+                    }
+                    std::sort(seeds.begin(), seeds.end());
+                    seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+                    if (seeds.empty())
+                    {
+                        automaton.transitions.push_back(-1);
+                        continue;
+                    }
+                    auto result = ids.emplace(seeds, static_cast<int>(states.size()));
+                    if (result.second)
+                    {
+                        if (states.size() == max_dfa_states)
+                        {
+                            return;
+                        }
+                        states.push_back(std::move(seeds));
+                    }
+                    automaton.transitions.push_back(result.first->second);
+                }
+            }
+            prog.automaton = std::move(automaton);
+            prog.has_dfa = true;
+        }
+
+        static uint32_t decode_one(const std::string& s, std::size_t& i)
+        {
+            const unsigned char b0 = static_cast<unsigned char>(s[i]);
+            std::size_t len;
+            uint32_t cp;
+            if (b0 < 0x80)
+            {
+                ++i;
+                return b0;
+            }
+            else if ((b0 & 0xE0) == 0xC0)
+            {
+                len = 2;
+                cp = b0 & 0x1F;
+            }
+            else if ((b0 & 0xF0) == 0xE0)
+            {
+                len = 3;
+                cp = b0 & 0x0F;
+            }
+            else if ((b0 & 0xF8) == 0xF0)
+            {
+                len = 4;
+                cp = b0 & 0x07;
+            }
+            else
+            {
+                ++i;
+                return b0; // invalid UTF-8; the byte itself
+            }
+            if (i + len > s.size())
+            {
+                ++i;
+                return b0;
+            }
+            for (std::size_t k = 1; k < len; ++k)
+            {
+                const unsigned char b = static_cast<unsigned char>(s[i + k]);
+                if ((b & 0xC0) != 0x80)
+                {
+                    ++i;
+                    return b0;
+                }
+                cp = (cp << 6) | (b & 0x3F);
+            }
+            i += len;
+            return cp;
+        }
+
+        static std::vector<uint32_t> decode(const std::string& s)
+        {
+            std::vector<uint32_t> result;
+            result.reserve(s.size());
+            std::size_t i = 0;
+            while (i < s.size())
+            {
+                result.push_back(decode_one(s, i));
+            }
+            return result;
+        }
+
+        static bool is_word(bool has_c, uint32_t c)
+        {
+            return has_c && ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                (c >= '0' && c <= '9') || c == '_');
+        }
+
+        static bool consumes(const program& prog, const instruction& inst, uint32_t c)
+        {
+            switch (inst.op)
+            {
+                case op_code::character:
+                    return c == inst.value;
+                case op_code::any:
+                    return c != '\n' && c != '\r' && c != 0x2028 && c != 0x2029;
+                case op_code::char_class:
+                    return prog.classes[inst.value].contains(c);
+                default:
+                    return false;
+            }
+        }
+
+        // add the thread at 'pc', and the threads reachable from it
+        // without consuming input, to 'list'; true if one matches.
+        // 'prev' and 'c' are the characters before and after the
+        // current position
+        static bool add_thread(const program& prog, std::size_t pc, std::vector<std::size_t>& list,
+            std::vector<std::size_t>& added, std::size_t generation, std::vector<std::size_t>& stack,
+            bool has_prev, uint32_t prev, bool has_c, uint32_t c)
+        {
+            stack.clear();
+            stack.push_back(pc);
+            while (!stack.empty())
+            {
+                pc = stack.back();
+                stack.pop_back();
+                if (added[pc] == generation)
+                {
+                    continue;
+                }
+                added[pc] = generation;
+                const instruction& inst = prog.instructions[pc];
+                switch (inst.op)
+                {
+                    case op_code::match:
+                        return true;
+                    case op_code::jump:
+                        stack.push_back(inst.x);
+                        break;
+                    case op_code::split:
+                        stack.push_back(inst.y);
+                        stack.push_back(inst.x);
+                        break;
+                    case op_code::assert_begin:
+                        if (!has_prev)
+                        {
+                            stack.push_back(pc + 1);
+                        }
+                        break;
+                    case op_code::assert_end:
+                        if (!has_c)
+                        {
+                            stack.push_back(pc + 1);
+                        }
+                        break;
+                    case op_code::word_boundary:
+                    case op_code::not_word_boundary:
+                        if ((is_word(has_prev, prev) != is_word(has_c, c)) == (inst.op == op_code::word_boundary))
+                        {
+                            stack.push_back(pc + 1);
+                        }
+                        break;
+                    default:
+                        list.push_back(pc);
+                        break;
+                }
+            }
+            return false;
+        }
+
+        static void emit(program& prog, const node& n)
+        {
+            auto& code = prog.instructions;
+            if (code.size() > max_program_size)
+            {
+                throw unsupported_pattern();
+            }
+            switch (n.kind)
+            {
+                case node_kind::character:
+                    code.push_back(instruction{op_code::character, n.value, 0, 0});
+                    break;
+                case node_kind::any:
+                    code.push_back(instruction{op_code::any, 0, 0, 0});
+                    break;
+                case node_kind::char_class:
+                    code.push_back(instruction{op_code::char_class, n.value, 0, 0});
+                    break;
+                case node_kind::assertion:
+                    code.push_back(instruction{static_cast<op_code>(n.value), 0, 0, 0});
+                    break;
+                case node_kind::concat:
+                    for (const auto& child : n.children)
+                    {
+                        emit(prog, *child);
+                    }
+                    break;
+                case node_kind::alternate:
+                {
+                    // split L1, L2; L1: a; jump end; L2: split ...; b
+                    std::vector<std::size_t> jumps;
+                    for (std::size_t i = 0; i < n.children.size(); ++i)
+                    {
+                        if (i + 1 < n.children.size())
+                        {
+                            std::size_t split = code.size();
+                            code.push_back(instruction{op_code::split, 0, split + 1, 0});
+                            emit(prog, *n.children[i]);
+                            jumps.push_back(code.size());
+                            code.push_back(instruction{op_code::jump, 0, 0, 0});
+                            code[split].y = code.size();
+                        }
+                        else
+                        {
+                            emit(prog, *n.children[i]);
+                        }
+                    }
+                    for (std::size_t jump : jumps)
+                    {
+                        code[jump].x = code.size();
+                    }
+                    break;
+                }
+                case node_kind::repeat:
+                {
+                    const node& child = *n.children.front();
+                    for (std::size_t i = 0; i < n.min; ++i)
+                    {
+                        emit(prog, child);
+                    }
+                    if (n.max == npos)
+                    {
+                        // L: split L1, end; L1: child; jump L; end:
+                        std::size_t split = code.size();
+                        code.push_back(instruction{op_code::split, 0, split + 1, 0});
+                        emit(prog, child);
+                        code.push_back(instruction{op_code::jump, 0, split, 0});
+                        code[split].y = code.size();
+                    }
+                    else
+                    {
+                        // optional copies: each may skip to the end
+                        std::vector<std::size_t> splits;
+                        for (std::size_t i = n.min; i < n.max; ++i)
+                        {
+                            splits.push_back(code.size());
+                            code.push_back(instruction{op_code::split, 0, code.size() + 1, 0});
+                            emit(prog, child);
+                        }
+                        for (std::size_t split : splits)
+                        {
+                            code[split].y = code.size();
+                        }
+                    }
+                    break;
+                }
+            }
+            if (code.size() > max_program_size)
+            {
+                throw unsupported_pattern();
+            }
+        }
+    };
+
+} // namespace rjsoncons
+
+#endif // RJSONCONS_SCHEMA_REGEX_HPP
@@ -0,0 +1,111 @@
+#include <jsoncons/json.hpp>
+
+#include "enum_index.h"
+#include "compiled_path.h"
+#include "rquerypivot.h"
+
+#include <cpp11/external_pointer.hpp>
+#include <cpp11/sexp.hpp>
+#include <cpp11/protect.hpp>    // 'stop'
+
+using namespace jsoncons;
+
+// payload of the external pointer returned by j_compile(); the
+// compiled path is shared with the compiled path cache, for the Json
+// type selected by 'object_names'
+struct j_compiled_path {
+    rjsoncons::object_names object_names;
+    std::shared_ptr<compiled_path<ojson>> asis;
+    std::shared_ptr<compiled_path<json>> sort;
+};
+
+const j_compiled_path& sexp_to_compiled_path(const sexp& compiled)
+{
+    external_pointer<j_compiled_path> ptr(compiled);
+    if (ptr.get() == nullptr) {
+        // e.g., after saveRDS() / readRDS()
+        cpp11::stop("compiled path is no longer valid; use `j_compile()`");
+    }
+    return *ptr;
+}
+
+[[cpp11::register]]
+sexp cpp_j_compile(
+    const std::string& path, const std::string& object_names,
+    const std::string& path_type)
+{
+    const auto type = enum_index(path_type_map, path_type);
+    std::unique_ptr<j_compiled_path> compiled(new j_compiled_path());
+    compiled->object_names = enum_index(object_names_map, object_names);
+    switch(compiled->object_names) {
+    case object_names::asis: {
+        compiled->asis = compile_path<ojson>(path, type);
+        break;
+    }
+    case object_names::sort: {
+        compiled->sort = compile_path<json>(path, type);
+        break;
+    }
+    default: {
+        cpp11::stop("unknown `object_names = '" + object_names + "'`");
+    }}
+
+    return external_pointer<j_compiled_path>(compiled.release());
+}
+
+[[cpp11::register]]
+sexp cpp_j_apply(
+    const std::vector<std::string>& data, const std::string& data_type,
+    const sexp& compiled, const std::string& as)
+{
+    const j_compiled_path& path = sexp_to_compiled_path(compiled);
+
+    sexp result;
+    switch(path.object_names) {
+    case object_names::asis: {
+        result =
+            rquerypivot<ojson>(path.asis, as, data_type, false).
+            query(data);
+        break;
+    }
+    case object_names::sort: {
+        result =
+            rquerypivot<json>(path.sort, as, data_type, false).
+            query(data);
+        break;
+    }
+    default: {
+        cpp11::stop("unknown `object_names =`");
+    }}
+
+    return result;
+}
+
+[[cpp11::register]]
+sexp cpp_j_apply_con(
+    const sexp& con, const std::string& data_type,
+    const sexp& compiled, const std::string& as,
+    const double n_records, const bool verbose)
+{
+    const j_compiled_path& path = sexp_to_compiled_path(compiled);
+
+    sexp result;
+    switch(path.object_names) {
+    case object_names::asis: {
+        result =
+            rquerypivot<ojson>(path.asis, as, data_type, verbose).
+            query(con, n_records);
+        break;
+    }
+    case object_names::sort: {
+        result =
+            rquerypivot<json>(path.sort, as, data_type, verbose).
+            query(con, n_records);
+        break;
+    }
+    default: {
+        cpp11::stop("unknown `object_names =`");
+    }}
+
+    return result;
+}
@@ -0,0 +1,117 @@
+#ifndef RJSONCONS_COMPILED_PATH_H
+#define RJSONCONS_COMPILED_PATH_H
+
+#include <memory>
+#include <string>
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/jmespath/jmespath.hpp>
+#include <jsoncons_ext/jsonpath/jsonpath.hpp>
+#include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
+
+#include "enum_index.h"
+#include "jmespath_fastpath.h"
+#include "lru_cache.h"
+
+#include <cpp11/protect.hpp>    // 'stop'
+
+using namespace jsoncons;
+using namespace rjsoncons;
+
+// A JSONpointer, JSONpath, or JMESpath 'path', compiled once and
+// evaluated against many documents
+
+template<class Json>
+class compiled_path
+{
+    const rjsoncons::path_type path_type_;
+    const std::string path_;
+    // only the expression corresponding to 'path_type_' is compiled
+    std::unique_ptr<jmespath_fastpath<Json>> jmespath_fastpath_;
+    std::unique_ptr<jmespath::jmespath_expression<Json>> jmespath_;
+    std::unique_ptr<jsonpath::jsonpath_expression<Json>> jsonpath_;
+
+public:
+    compiled_path(const std::string& path, rjsoncons::path_type path_type)
+        : path_type_(path_type), path_(path)
+        {
+            switch(path_type_) {
+            case path_type::JSONpointer: break;
+            case path_type::JSONpath: {
+                jsonpath_.reset(new jsonpath::jsonpath_expression<Json>(
+                    jsonpath::make_expression<Json>(path_)));
+                break;
+            }
+            case path_type::JMESpath: {
+                jmespath_fastpath_.reset(new jmespath_fastpath<Json>(path_));
+                // the jsoncons interpreter is only needed without a fast path
+                if (!jmespath_fastpath_->supported())
+                    jmespath_.reset(new jmespath::jmespath_expression<Json>(
+                        jmespath::make_expression<Json>(path_)));
+                break;
+            }
+            default: cpp11::stop("unknown 'path_type'");
+            }
+        }
+
+    rjsoncons::path_type type() const
+        {
+            return path_type_;
+        }
+
+    const std::string& path() const
+        {
+            return path_;
+        }
+
+    Json evaluate(const Json& j)
+        {
+            switch(path_type_) {
+            case path_type::JSONpointer:
+                return jsonpointer::get<Json>(j, path_);
+            case path_type::JSONpath:
+                // the default options select values only, without path
+                // nodes; jsoncons' callback overloads add
+                // result_options::path, so are not used
+                return jsonpath_->evaluate(j);
+            case path_type::JMESpath:
+                return jmespath_ ?
+                    jmespath_->evaluate(j) : jmespath_fastpath_->evaluate(j);
+            default: cpp11::stop("unknown 'path_type'");
+            }
+        }
+
+    // does the path select the whole document, e.g., JSONpointer ""?
+    bool is_identity() const
+        {
+            return
+                (path_type_ == path_type::JSONpointer && path_.empty()) ||
+                (path_type_ == path_type::JMESpath && path_ == "@");
+        }
+
+    // use as a predicate, e.g., to filter NDJSON records; a JSONpath
+    // with no matches evaluates to '[]' and so is false
+    bool test(const Json& j)
+        {
+            return !jmespath_fastpath<Json>::is_false(evaluate(j));
+        }
+};
+
+// compiled paths are cached across calls, keyed by 'path' and
+// 'path_type'; the Json template parameter (from `object_names =`)
+// selects a separate cache
+
+template<class Json>
+std::shared_ptr<compiled_path<Json>>
+compile_path(const std::string& path, rjsoncons::path_type path_type)
+{
+    static lru_cache<
+        std::pair<std::string, rjsoncons::path_type>, compiled_path<Json>
+        > cache(128);
+    return cache.get(
+        std::make_pair(path, path_type),
+        [&]() { return std::make_shared<compiled_path<Json>>(path, path_type); }
+    );
+}
+
+#endif
@@ -5,6 +5,27 @@
 #include "cpp11/declarations.hpp"
 #include <R_ext/Visibility.h>
 
+// compile.cpp
+sexp cpp_j_compile(const std::string& path, const std::string& object_names, const std::string& path_type);
+extern "C" SEXP _rjsoncons_cpp_j_compile(SEXP path, SEXP object_names, SEXP path_type) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_compile(cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type)));
+  END_CPP11
+}
+// compile.cpp
+sexp cpp_j_apply(const std::vector<std::string>& data, const std::string& data_type, const sexp& compiled, const std::string& as);
+extern "C" SEXP _rjsoncons_cpp_j_apply(SEXP data, SEXP data_type, SEXP compiled, SEXP as) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_apply(cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(data), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(compiled), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as)));
+  END_CPP11
+}
+// compile.cpp
+sexp cpp_j_apply_con(const sexp& con, const std::string& data_type, const sexp& compiled, const std::string& as, const double n_records, const bool verbose);
+extern "C" SEXP _rjsoncons_cpp_j_apply_con(SEXP con, SEXP data_type, SEXP compiled, SEXP as, SEXP n_records, SEXP verbose) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_apply_con(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(con), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(compiled), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const double>>(n_records), cpp11::as_cpp<cpp11::decay_t<const bool>>(verbose)));
+  END_CPP11
+}
 // flatten.cpp
 sexp cpp_j_flatten(const std::vector<std::string>& data, const std::string& data_type, const std::string& object_names, const std::string& as, const std::string& path, const std::string& path_type);
 extern "C" SEXP _rjsoncons_cpp_j_flatten(SEXP data, SEXP data_type, SEXP object_names, SEXP as, SEXP path, SEXP path_type) {
@@ -19,6 +40,55 @@ extern "C" SEXP _rjsoncons_cpp_j_flatten_con(SEXP con, SEXP data_type, SEXP obje
     return cpp11::as_sexp(cpp_j_flatten_con(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(con), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type), cpp11::as_cpp<cpp11::decay_t<const double>>(n_records), cpp11::as_cpp<cpp11::decay_t<const bool>>(verbose)));
   END_CPP11
 }
+// flatten.cpp
+sexp cpp_j_flatten_columns(const std::vector<std::string>& data, const std::string& data_type, const std::string& object_names, const std::string& path, const std::string& path_type);
+extern "C" SEXP _rjsoncons_cpp_j_flatten_columns(SEXP data, SEXP data_type, SEXP object_names, SEXP path, SEXP path_type) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_flatten_columns(cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(data), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type)));
+  END_CPP11
+}
+// flatten.cpp
+sexp cpp_j_flatten_columns_con(const sexp& con, const std::string& data_type, const std::string& object_names, const std::string& path, const std::string& path_type, const double n_records, const bool verbose);
+extern "C" SEXP _rjsoncons_cpp_j_flatten_columns_con(SEXP con, SEXP data_type, SEXP object_names, SEXP path, SEXP path_type, SEXP n_records, SEXP verbose) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_flatten_columns_con(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(con), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type), cpp11::as_cpp<cpp11::decay_t<const double>>(n_records), cpp11::as_cpp<cpp11::decay_t<const bool>>(verbose)));
+  END_CPP11
+}
+// flatten.cpp
+sexp cpp_j_unflatten(const std::vector<std::string>& data, const std::string& data_type, const std::string& object_names, const std::string& as, const std::string& path, const std::string& path_type);
+extern "C" SEXP _rjsoncons_cpp_j_unflatten(SEXP data, SEXP data_type, SEXP object_names, SEXP as, SEXP path, SEXP path_type) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_unflatten(cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(data), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type)));
+  END_CPP11
+}
+// flatten.cpp
+sexp cpp_j_unflatten_con(const sexp& con, const std::string& data_type, const std::string& object_names, const std::string& as, const std::string& path, const std::string& path_type, const double n_records, const bool verbose);
+extern "C" SEXP _rjsoncons_cpp_j_unflatten_con(SEXP con, SEXP data_type, SEXP object_names, SEXP as, SEXP path, SEXP path_type, SEXP n_records, SEXP verbose) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_unflatten_con(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(con), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type), cpp11::as_cpp<cpp11::decay_t<const double>>(n_records), cpp11::as_cpp<cpp11::decay_t<const bool>>(verbose)));
+  END_CPP11
+}
+// flatten.cpp
+sexp cpp_j_unflatten_columns(const std::vector<int>& record_id, const std::vector<std::string>& path, const sexp& value, const std::string& object_names, const std::string& as, const std::string& root, const std::string& path_type);
+extern "C" SEXP _rjsoncons_cpp_j_unflatten_columns(SEXP record_id, SEXP path, SEXP value, SEXP object_names, SEXP as, SEXP root, SEXP path_type) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_unflatten_columns(cpp11::as_cpp<cpp11::decay_t<const std::vector<int>&>>(record_id), cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(path), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(value), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(root), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type)));
+  END_CPP11
+}
+// flatten.cpp
+sexp cpp_j_find(const std::vector<std::string>& data, const std::string& data_type, const std::string& object_names, const std::string& path, const std::string& path_type, const std::string& find_type, const sexp& target);
+extern "C" SEXP _rjsoncons_cpp_j_find(SEXP data, SEXP data_type, SEXP object_names, SEXP path, SEXP path_type, SEXP find_type, SEXP target) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_find(cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(data), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(find_type), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(target)));
+  END_CPP11
+}
+// flatten.cpp
+sexp cpp_j_find_con(const sexp& con, const std::string& data_type, const std::string& object_names, const std::string& path, const std::string& path_type, const std::string& find_type, const sexp& target, const double n_records, const bool verbose);
+extern "C" SEXP _rjsoncons_cpp_j_find_con(SEXP con, SEXP data_type, SEXP object_names, SEXP path, SEXP path_type, SEXP find_type, SEXP target, SEXP n_records, SEXP verbose) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_find_con(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(con), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(find_type), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(target), cpp11::as_cpp<cpp11::decay_t<const double>>(n_records), cpp11::as_cpp<cpp11::decay_t<const bool>>(verbose)));
+  END_CPP11
+}
 // patch.cpp
 sexp cpp_j_patch_apply(const std::string& data, const std::string& data_type, const std::string& patch, const std::string& as);
 extern "C" SEXP _rjsoncons_cpp_j_patch_apply(SEXP data, SEXP data_type, SEXP patch, SEXP as) {
@@ -62,64 +132,162 @@ extern "C" SEXP _rjsoncons_cpp_as_r_con(SEXP con, SEXP data_type, SEXP object_na
   END_CPP11
 }
 // rjsoncons.cpp
-sexp cpp_j_query(const std::vector<std::string>& data, const std::string& data_type, const std::string& object_names, const std::string& as, const std::string& path, const std::string& path_type);
-extern "C" SEXP _rjsoncons_cpp_j_query(SEXP data, SEXP data_type, SEXP object_names, SEXP as, SEXP path, SEXP path_type) {
+sexp cpp_j_query(const std::vector<std::string>& data, const std::string& data_type, const std::string& object_names, const std::string& as, const std::string& path, const std::string& path_type, const std::string& filter, const std::string& filter_type, const std::vector<std::string>& prefilter);
+extern "C" SEXP _rjsoncons_cpp_j_query(SEXP data, SEXP data_type, SEXP object_names, SEXP as, SEXP path, SEXP path_type, SEXP filter, SEXP filter_type, SEXP prefilter) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_query(cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(data), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(filter), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(filter_type), cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(prefilter)));
+  END_CPP11
+}
+// rjsoncons.cpp
+sexp cpp_j_query_con(const sexp& con, const std::string& data_type, const std::string& object_names, const std::string& as, const std::string& path, const std::string& path_type, const std::string& filter, const std::string& filter_type, const std::vector<std::string>& prefilter, const double n_records, const bool verbose);
+extern "C" SEXP _rjsoncons_cpp_j_query_con(SEXP con, SEXP data_type, SEXP object_names, SEXP as, SEXP path, SEXP path_type, SEXP filter, SEXP filter_type, SEXP prefilter, SEXP n_records, SEXP verbose) {
   BEGIN_CPP11
-    return cpp11::as_sexp(cpp_j_query(cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(data), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type)));
+    return cpp11::as_sexp(cpp_j_query_con(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(con), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(filter), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(filter_type), cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(prefilter), cpp11::as_cpp<cpp11::decay_t<const double>>(n_records), cpp11::as_cpp<cpp11::decay_t<const bool>>(verbose)));
   END_CPP11
 }
 // rjsoncons.cpp
-sexp cpp_j_query_con(const sexp& con, const std::string& data_type, const std::string& object_names, const std::string& as, const std::string& path, const std::string& path_type, const double n_records, const bool verbose);
-extern "C" SEXP _rjsoncons_cpp_j_query_con(SEXP con, SEXP data_type, SEXP object_names, SEXP as, SEXP path, SEXP path_type, SEXP n_records, SEXP verbose) {
+sexp cpp_j_query_multi(const std::vector<std::string>& data, const std::string& data_type, const std::string& object_names, const std::string& as, const std::vector<std::string>& paths, const std::vector<std::string>& path_types);
+extern "C" SEXP _rjsoncons_cpp_j_query_multi(SEXP data, SEXP data_type, SEXP object_names, SEXP as, SEXP paths, SEXP path_types) {
   BEGIN_CPP11
-    return cpp11::as_sexp(cpp_j_query_con(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(con), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type), cpp11::as_cpp<cpp11::decay_t<const double>>(n_records), cpp11::as_cpp<cpp11::decay_t<const bool>>(verbose)));
+    return cpp11::as_sexp(cpp_j_query_multi(cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(data), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(paths), cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(path_types)));
   END_CPP11
 }
 // rjsoncons.cpp
-sexp cpp_j_pivot(const std::vector<std::string>& data, const std::string& data_type, const std::string& object_names, const std::string& as, const std::string& path, const std::string& path_type);
-extern "C" SEXP _rjsoncons_cpp_j_pivot(SEXP data, SEXP data_type, SEXP object_names, SEXP as, SEXP path, SEXP path_type) {
+sexp cpp_j_query_multi_con(const sexp& con, const std::string& data_type, const std::string& object_names, const std::string& as, const std::vector<std::string>& paths, const std::vector<std::string>& path_types, const double n_records, const bool verbose);
+extern "C" SEXP _rjsoncons_cpp_j_query_multi_con(SEXP con, SEXP data_type, SEXP object_names, SEXP as, SEXP paths, SEXP path_types, SEXP n_records, SEXP verbose) {
   BEGIN_CPP11
-    return cpp11::as_sexp(cpp_j_pivot(cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(data), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type)));
+    return cpp11::as_sexp(cpp_j_query_multi_con(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(con), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(paths), cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(path_types), cpp11::as_cpp<cpp11::decay_t<const double>>(n_records), cpp11::as_cpp<cpp11::decay_t<const bool>>(verbose)));
   END_CPP11
 }
 // rjsoncons.cpp
-sexp cpp_j_pivot_con(const sexp& con, const std::string& data_type, const std::string& object_names, const std::string& as, const std::string& path, const std::string& path_type, const double n_records, const bool verbose);
-extern "C" SEXP _rjsoncons_cpp_j_pivot_con(SEXP con, SEXP data_type, SEXP object_names, SEXP as, SEXP path, SEXP path_type, SEXP n_records, SEXP verbose) {
+sexp cpp_j_pivot(const std::vector<std::string>& data, const std::string& data_type, const std::string& object_names, const std::string& as, const std::string& path, const std::string& path_type, const std::string& filter, const std::string& filter_type, const std::vector<std::string>& prefilter, const int threads, const std::string& unnest, const std::vector<std::string>& col_names, const std::vector<std::string>& col_types);
+extern "C" SEXP _rjsoncons_cpp_j_pivot(SEXP data, SEXP data_type, SEXP object_names, SEXP as, SEXP path, SEXP path_type, SEXP filter, SEXP filter_type, SEXP prefilter, SEXP threads, SEXP unnest, SEXP col_names, SEXP col_types) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_pivot(cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(data), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(filter), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(filter_type), cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(prefilter), cpp11::as_cpp<cpp11::decay_t<const int>>(threads), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(unnest), cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(col_names), cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(col_types)));
+  END_CPP11
+}
+// rjsoncons.cpp
+sexp cpp_j_pivot_con(const sexp& con, const std::string& data_type, const std::string& object_names, const std::string& as, const std::string& path, const std::string& path_type, const std::string& filter, const std::string& filter_type, const std::vector<std::string>& prefilter, const int threads, const std::string& unnest, const std::vector<std::string>& col_names, const std::vector<std::string>& col_types, const double n_records, const bool verbose);
+extern "C" SEXP _rjsoncons_cpp_j_pivot_con(SEXP con, SEXP data_type, SEXP object_names, SEXP as, SEXP path, SEXP path_type, SEXP filter, SEXP filter_type, SEXP prefilter, SEXP threads, SEXP unnest, SEXP col_names, SEXP col_types, SEXP n_records, SEXP verbose) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_pivot_con(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(con), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(filter), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(filter_type), cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(prefilter), cpp11::as_cpp<cpp11::decay_t<const int>>(threads), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(unnest), cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(col_names), cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(col_types), cpp11::as_cpp<cpp11::decay_t<const double>>(n_records), cpp11::as_cpp<cpp11::decay_t<const bool>>(verbose)));
+  END_CPP11
+}
+// schema.cpp
+sexp cpp_j_schema_registry(const std::vector<std::string>& schemas);
+extern "C" SEXP _rjsoncons_cpp_j_schema_registry(SEXP schemas) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_schema_registry(cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(schemas)));
+  END_CPP11
+}
+// schema.cpp
+std::vector<std::string> cpp_j_schema_registry_uris(const sexp& registry);
+extern "C" SEXP _rjsoncons_cpp_j_schema_registry_uris(SEXP registry) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_schema_registry_uris(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(registry)));
+  END_CPP11
+}
+// schema.cpp
+sexp cpp_j_schema_compile(const sexp& schema, const sexp& registry);
+extern "C" SEXP _rjsoncons_cpp_j_schema_compile(SEXP schema, SEXP registry) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_schema_compile(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(schema), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(registry)));
+  END_CPP11
+}
+// schema.cpp
+bool cpp_j_schema_is_valid(const sexp& data, const sexp& schema, const sexp& registry);
+extern "C" SEXP _rjsoncons_cpp_j_schema_is_valid(SEXP data, SEXP schema, SEXP registry) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_schema_is_valid(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(data), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(schema), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(registry)));
+  END_CPP11
+}
+// schema.cpp
+sexp cpp_j_schema_validate(const sexp& data, const sexp& schema, const std::string& as, const sexp& registry);
+extern "C" SEXP _rjsoncons_cpp_j_schema_validate(SEXP data, SEXP schema, SEXP as, SEXP registry) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_schema_validate(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(data), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(schema), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(registry)));
+  END_CPP11
+}
+// schema.cpp
+sexp cpp_j_schema_is_valid_ndjson(const std::vector<std::string>& data, const std::string& data_type, const sexp& schema, const bool stop_on_invalid, const int threads);
+extern "C" SEXP _rjsoncons_cpp_j_schema_is_valid_ndjson(SEXP data, SEXP data_type, SEXP schema, SEXP stop_on_invalid, SEXP threads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_schema_is_valid_ndjson(cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(data), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(schema), cpp11::as_cpp<cpp11::decay_t<const bool>>(stop_on_invalid), cpp11::as_cpp<cpp11::decay_t<const int>>(threads)));
+  END_CPP11
+}
+// schema.cpp
+sexp cpp_j_schema_is_valid_ndjson_con(const sexp& con, const std::string& data_type, const sexp& schema, const bool stop_on_invalid, const int threads, const double n_records, const bool verbose);
+extern "C" SEXP _rjsoncons_cpp_j_schema_is_valid_ndjson_con(SEXP con, SEXP data_type, SEXP schema, SEXP stop_on_invalid, SEXP threads, SEXP n_records, SEXP verbose) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_schema_is_valid_ndjson_con(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(con), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(schema), cpp11::as_cpp<cpp11::decay_t<const bool>>(stop_on_invalid), cpp11::as_cpp<cpp11::decay_t<const int>>(threads), cpp11::as_cpp<cpp11::decay_t<const double>>(n_records), cpp11::as_cpp<cpp11::decay_t<const bool>>(verbose)));
+  END_CPP11
+}
+// schema.cpp
+sexp cpp_j_schema_validate_ndjson(const std::vector<std::string>& data, const std::string& data_type, const sexp& schema, const std::string& as, const bool stop_on_invalid, const int threads);
+extern "C" SEXP _rjsoncons_cpp_j_schema_validate_ndjson(SEXP data, SEXP data_type, SEXP schema, SEXP as, SEXP stop_on_invalid, SEXP threads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cpp_j_schema_validate_ndjson(cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(data), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(schema), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const bool>>(stop_on_invalid), cpp11::as_cpp<cpp11::decay_t<const int>>(threads)));
+  END_CPP11
+}
+// schema.cpp
+sexp cpp_j_schema_validate_ndjson_con(const sexp& con, const std::string& data_type, const sexp& schema, const std::string& as, const bool stop_on_invalid, const int threads, const double n_records, const bool verbose);
+extern "C" SEXP _rjsoncons_cpp_j_schema_validate_ndjson_con(SEXP con, SEXP data_type, SEXP schema, SEXP as, SEXP stop_on_invalid, SEXP threads, SEXP n_records, SEXP verbose) {
   BEGIN_CPP11
-    return cpp11::as_sexp(cpp_j_pivot_con(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(con), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(object_names), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(path_type), cpp11::as_cpp<cpp11::decay_t<const double>>(n_records), cpp11::as_cpp<cpp11::decay_t<const bool>>(verbose)));
+    return cpp11::as_sexp(cpp_j_schema_validate_ndjson_con(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(con), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(schema), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as), cpp11::as_cpp<cpp11::decay_t<const bool>>(stop_on_invalid), cpp11::as_cpp<cpp11::decay_t<const int>>(threads), cpp11::as_cpp<cpp11::decay_t<const double>>(n_records), cpp11::as_cpp<cpp11::decay_t<const bool>>(verbose)));
   END_CPP11
 }
 // schema.cpp
-bool cpp_j_schema_is_valid(const sexp& data, const sexp& schema);
-extern "C" SEXP _rjsoncons_cpp_j_schema_is_valid(SEXP data, SEXP schema) {
+sexp cpp_j_schema_pivot(const std::vector<std::string>& data, const std::string& data_type, const sexp& schema, const int threads);
+extern "C" SEXP _rjsoncons_cpp_j_schema_pivot(SEXP data, SEXP data_type, SEXP schema, SEXP threads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(cpp_j_schema_is_valid(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(data), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(schema)));
+    return cpp11::as_sexp(cpp_j_schema_pivot(cpp11::as_cpp<cpp11::decay_t<const std::vector<std::string>&>>(data), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(schema), cpp11::as_cpp<cpp11::decay_t<const int>>(threads)));
   END_CPP11
 }
 // schema.cpp
-sexp cpp_j_schema_validate(const sexp& data, const sexp& schema, const std::string& as);
-extern "C" SEXP _rjsoncons_cpp_j_schema_validate(SEXP data, SEXP schema, SEXP as) {
+sexp cpp_j_schema_pivot_con(const sexp& con, const std::string& data_type, const sexp& schema, const int threads, const double n_records, const bool verbose);
+extern "C" SEXP _rjsoncons_cpp_j_schema_pivot_con(SEXP con, SEXP data_type, SEXP schema, SEXP threads, SEXP n_records, SEXP verbose) {
   BEGIN_CPP11
-    return cpp11::as_sexp(cpp_j_schema_validate(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(data), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(schema), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(as)));
+    return cpp11::as_sexp(cpp_j_schema_pivot_con(cpp11::as_cpp<cpp11::decay_t<const sexp&>>(con), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(data_type), cpp11::as_cpp<cpp11::decay_t<const sexp&>>(schema), cpp11::as_cpp<cpp11::decay_t<const int>>(threads), cpp11::as_cpp<cpp11::decay_t<const double>>(n_records), cpp11::as_cpp<cpp11::decay_t<const bool>>(verbose)));
   END_CPP11
 }
 
 extern "C" {
 static const R_CallMethodDef CallEntries[] = {
-    {"_rjsoncons_cpp_as_r",              (DL_FUNC) &_rjsoncons_cpp_as_r,              3},
-    {"_rjsoncons_cpp_as_r_con",          (DL_FUNC) &_rjsoncons_cpp_as_r_con,          5},
-    {"_rjsoncons_cpp_j_flatten",         (DL_FUNC) &_rjsoncons_cpp_j_flatten,         6},
-    {"_rjsoncons_cpp_j_flatten_con",     (DL_FUNC) &_rjsoncons_cpp_j_flatten_con,     8},
-    {"_rjsoncons_cpp_j_patch_apply",     (DL_FUNC) &_rjsoncons_cpp_j_patch_apply,     4},
-    {"_rjsoncons_cpp_j_patch_from",      (DL_FUNC) &_rjsoncons_cpp_j_patch_from,      5},
-    {"_rjsoncons_cpp_j_patch_print",     (DL_FUNC) &_rjsoncons_cpp_j_patch_print,     3},
-    {"_rjsoncons_cpp_j_pivot",           (DL_FUNC) &_rjsoncons_cpp_j_pivot,           6},
-    {"_rjsoncons_cpp_j_pivot_con",       (DL_FUNC) &_rjsoncons_cpp_j_pivot_con,       8},
-    {"_rjsoncons_cpp_j_query",           (DL_FUNC) &_rjsoncons_cpp_j_query,           6},
-    {"_rjsoncons_cpp_j_query_con",       (DL_FUNC) &_rjsoncons_cpp_j_query_con,       8},
-    {"_rjsoncons_cpp_j_schema_is_valid", (DL_FUNC) &_rjsoncons_cpp_j_schema_is_valid, 2},
-    {"_rjsoncons_cpp_j_schema_validate", (DL_FUNC) &_rjsoncons_cpp_j_schema_validate, 3},
-    {"_rjsoncons_cpp_version",           (DL_FUNC) &_rjsoncons_cpp_version,           0},
+    {"_rjsoncons_cpp_as_r",                         (DL_FUNC) &_rjsoncons_cpp_as_r,                         3},
+    {"_rjsoncons_cpp_as_r_con",                     (DL_FUNC) &_rjsoncons_cpp_as_r_con,                     5},
+    {"_rjsoncons_cpp_j_apply",                      (DL_FUNC) &_rjsoncons_cpp_j_apply,                      4},
+    {"_rjsoncons_cpp_j_apply_con",                  (DL_FUNC) &_rjsoncons_cpp_j_apply_con,                  6},
+    {"_rjsoncons_cpp_j_compile",                    (DL_FUNC) &_rjsoncons_cpp_j_compile,                    3},
+    {"_rjsoncons_cpp_j_find",                       (DL_FUNC) &_rjsoncons_cpp_j_find,                       7},
+    {"_rjsoncons_cpp_j_find_con",                   (DL_FUNC) &_rjsoncons_cpp_j_find_con,                   9},
+    {"_rjsoncons_cpp_j_flatten",                    (DL_FUNC) &_rjsoncons_cpp_j_flatten,                    6},
+    {"_rjsoncons_cpp_j_flatten_columns",            (DL_FUNC) &_rjsoncons_cpp_j_flatten_columns,            5},
+    {"_rjsoncons_cpp_j_flatten_columns_con",        (DL_FUNC) &_rjsoncons_cpp_j_flatten_columns_con,        7},
+    {"_rjsoncons_cpp_j_flatten_con",                (DL_FUNC) &_rjsoncons_cpp_j_flatten_con,                8},
+    {"_rjsoncons_cpp_j_patch_apply",                (DL_FUNC) &_rjsoncons_cpp_j_patch_apply,                4},
+    {"_rjsoncons_cpp_j_patch_from",                 (DL_FUNC) &_rjsoncons_cpp_j_patch_from,                 5},
+    {"_rjsoncons_cpp_j_patch_print",                (DL_FUNC) &_rjsoncons_cpp_j_patch_print,                3},
+    {"_rjsoncons_cpp_j_pivot",                      (DL_FUNC) &_rjsoncons_cpp_j_pivot,                      13},
+    {"_rjsoncons_cpp_j_pivot_con",                  (DL_FUNC) &_rjsoncons_cpp_j_pivot_con,                  15},
+    {"_rjsoncons_cpp_j_query",                      (DL_FUNC) &_rjsoncons_cpp_j_query,                      9},
+    {"_rjsoncons_cpp_j_query_con",                  (DL_FUNC) &_rjsoncons_cpp_j_query_con,                  11},
+    {"_rjsoncons_cpp_j_query_multi",                (DL_FUNC) &_rjsoncons_cpp_j_query_multi,                6},
+    {"_rjsoncons_cpp_j_query_multi_con",            (DL_FUNC) &_rjsoncons_cpp_j_query_multi_con,            8},
+    {"_rjsoncons_cpp_j_schema_compile",             (DL_FUNC) &_rjsoncons_cpp_j_schema_compile,             2},
+    {"_rjsoncons_cpp_j_schema_is_valid",            (DL_FUNC) &_rjsoncons_cpp_j_schema_is_valid,            3},
+    {"_rjsoncons_cpp_j_schema_is_valid_ndjson",     (DL_FUNC) &_rjsoncons_cpp_j_schema_is_valid_ndjson,     5},
+    {"_rjsoncons_cpp_j_schema_is_valid_ndjson_con", (DL_FUNC) &_rjsoncons_cpp_j_schema_is_valid_ndjson_con, 7},
+    {"_rjsoncons_cpp_j_schema_pivot",               (DL_FUNC) &_rjsoncons_cpp_j_schema_pivot,               4},
+    {"_rjsoncons_cpp_j_schema_pivot_con",           (DL_FUNC) &_rjsoncons_cpp_j_schema_pivot_con,           6},
+    {"_rjsoncons_cpp_j_schema_registry",            (DL_FUNC) &_rjsoncons_cpp_j_schema_registry,            1},
+    {"_rjsoncons_cpp_j_schema_registry_uris",       (DL_FUNC) &_rjsoncons_cpp_j_schema_registry_uris,       1},
+    {"_rjsoncons_cpp_j_schema_validate",            (DL_FUNC) &_rjsoncons_cpp_j_schema_validate,            4},
+    {"_rjsoncons_cpp_j_schema_validate_ndjson",     (DL_FUNC) &_rjsoncons_cpp_j_schema_validate_ndjson,     6},
+    {"_rjsoncons_cpp_j_schema_validate_ndjson_con", (DL_FUNC) &_rjsoncons_cpp_j_schema_validate_ndjson_con, 8},
+    {"_rjsoncons_cpp_j_unflatten",                  (DL_FUNC) &_rjsoncons_cpp_j_unflatten,                  6},
+    {"_rjsoncons_cpp_j_unflatten_columns",          (DL_FUNC) &_rjsoncons_cpp_j_unflatten_columns,          7},
+    {"_rjsoncons_cpp_j_unflatten_con",              (DL_FUNC) &_rjsoncons_cpp_j_unflatten_con,              8},
+    {"_rjsoncons_cpp_version",                      (DL_FUNC) &_rjsoncons_cpp_version,                      0},
     {NULL, NULL, 0}
 };
 }
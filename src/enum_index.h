@@ -12,6 +12,11 @@ namespace rjsoncons {           // enums
     enum object_names { asis, sort };
     enum as { string, R };
     enum path_type { JSONpointer, JSONpath, JMESpath };
+    enum find_type { find_keys, find_values, find_keys_grep, find_values_grep };
+    enum col_type {
+        logical_col_type, integer_col_type, numeric_col_type,
+        character_col_type, list_col_type
+    };
 
     static std::map<std::string, data_type> data_type_map {
         {"json", json_data_type}, {"ndjson", ndjson_data_type}
@@ -30,6 +35,17 @@ namespace rjsoncons {           // enums
         {"JMESpath", JMESpath}
     };
 
+    static std::map<std::string, find_type> find_type_map {
+        {"keys", find_keys}, {"values", find_values},
+        {"keys_grep", find_keys_grep}, {"values_grep", find_values_grep}
+    };
+
+    static std::map<std::string, col_type> col_type_map {
+        {"logical", logical_col_type}, {"integer", integer_col_type},
+        {"numeric", numeric_col_type}, {"character", character_col_type},
+        {"list", list_col_type}
+    };
+
     // look up 'key' in 'enum_map', returning index; used to translate
     // R string to enum value.
     template<class T>
@@ -63,3 +63,200 @@ sexp cpp_j_flatten_con(
 
     return result;
 }
+
+[[cpp11::register]]
+sexp cpp_j_flatten_columns(
+    const std::vector<std::string>& data, const std::string& data_type,
+    const std::string& object_names, const std::string& path,
+    const std::string& path_type)
+{
+    sexp result;
+    switch(enum_index(object_names_map, object_names)) {
+    case object_names::asis: {
+        result =
+            rquerypivot<ojson>(path, "R", data_type, path_type, false).
+            flatten_columns(data);
+        break;
+    }
+    case object_names::sort: {
+        result =
+            rquerypivot<json>(path, "R", data_type, path_type, false).
+            flatten_columns(data);
+        break;
+    }
+    default: {
+        cpp11::stop("unknown `object_names = '" + object_names + "'`");
+    }}
+
+    return result;
+}
+
+[[cpp11::register]]
+sexp cpp_j_flatten_columns_con(
+    const sexp& con, const std::string& data_type,
+    const std::string& object_names, const std::string& path,
+    const std::string& path_type, const double n_records, const bool verbose)
+{
+    sexp result;
+    switch(enum_index(object_names_map, object_names)) {
+    case object_names::asis: {
+        result =
+            rquerypivot<ojson>(path, "R", data_type, path_type, verbose).
+            flatten_columns(con, n_records);
+        break;
+    }
+    case object_names::sort: {
+        result =
+            rquerypivot<json>(path, "R", data_type, path_type, verbose).
+            flatten_columns(con, n_records);
+        break;
+    }
+    default: {
+        cpp11::stop("unknown `object_names = '" + object_names + "'`");
+    }}
+
+    return result;
+}
+
+// j_unflatten()
+
+[[cpp11::register]]
+sexp cpp_j_unflatten(
+    const std::vector<std::string>& data, const std::string& data_type,
+    const std::string& object_names, const std::string& as,
+    const std::string& path, const std::string& path_type)
+{
+    sexp result;
+    switch(enum_index(object_names_map, object_names)) {
+    case object_names::asis: {
+        result =
+            rquerypivot<ojson>(path, as, data_type, path_type, false).
+            unflatten(data);
+        break;
+    }
+    case object_names::sort: {
+        result =
+            rquerypivot<json>(path, as, data_type, path_type, false).
+            unflatten(data);
+        break;
+    }
+    default: {
+        cpp11::stop("unknown `object_names = '" + object_names + "'`");
+    }}
+
+    return result;
+}
+
+[[cpp11::register]]
+sexp cpp_j_unflatten_con(
+    const sexp& con, const std::string& data_type,
+    const std::string& object_names, const std::string& as,
+    const std::string& path, const std::string& path_type,
+    const double n_records, const bool verbose)
+{
+    sexp result;
+    switch(enum_index(object_names_map, object_names)) {
+    case object_names::asis: {
+        result =
+            rquerypivot<ojson>(path, as, data_type, path_type, verbose).
+            unflatten(con, n_records);
+        break;
+    }
+    case object_names::sort: {
+        result =
+            rquerypivot<json>(path, as, data_type, path_type, verbose).
+            unflatten(con, n_records);
+        break;
+    }
+    default: {
+        cpp11::stop("unknown `object_names = '" + object_names + "'`");
+    }}
+
+    return result;
+}
+
+[[cpp11::register]]
+sexp cpp_j_unflatten_columns(
+    const std::vector<int>& record_id, const std::vector<std::string>& path,
+    const sexp& value, const std::string& object_names,
+    const std::string& as, const std::string& root,
+    const std::string& path_type)
+{
+    sexp result;
+    switch(enum_index(object_names_map, object_names)) {
+    case object_names::asis: {
+        result =
+            rquerypivot<ojson>(root, as, "json", path_type, false).
+            unflatten(record_id, path, value);
+        break;
+    }
+    case object_names::sort: {
+        result =
+            rquerypivot<json>(root, as, "json", path_type, false).
+            unflatten(record_id, path, value);
+        break;
+    }
+    default: {
+        cpp11::stop("unknown `object_names = '" + object_names + "'`");
+    }}
+
+    return result;
+}
+
+// j_find_*()
+
+[[cpp11::register]]
+sexp cpp_j_find(
+    const std::vector<std::string>& data, const std::string& data_type,
+    const std::string& object_names, const std::string& path,
+    const std::string& path_type, const std::string& find_type,
+    const sexp& target)
+{
+    sexp result;
+    switch(enum_index(object_names_map, object_names)) {
+    case object_names::asis: {
+        result =
+            rquerypivot<ojson>(path, "R", data_type, path_type, false).
+            find(data, find_type, target);
+        break;
+    }
+    case object_names::sort: {
+        result =
+            rquerypivot<json>(path, "R", data_type, path_type, false).
+            find(data, find_type, target);
+        break;
+    }
+    default: {
+        cpp11::stop("unknown `object_names = '" + object_names + "'`");
+    }}
+
+    return result;
+}
+
+[[cpp11::register]]
+sexp cpp_j_find_con(
+    const sexp& con, const std::string& data_type,
+    const std::string& object_names, const std::string& path,
+    const std::string& path_type, const std::string& find_type,
+    const sexp& target, const double n_records, const bool verbose)
+{
+    sexp result;
+    switch(enum_index(object_names_map, object_names)) {
+    case object_names::asis: {
+        result =
+            rquerypivot<ojson>(path, "R", data_type, path_type, verbose).
+            find(con, n_records, find_type, target);
+        break;
+    }
+    case object_names::sort: {
+        result =
+            rquerypivot<json>(path, "R", data_type, path_type, verbose).
+            find(con, n_records, find_type, target);
+        break;
+    }
+    default: {
+        cpp11::stop("unknown `object_names = '" + object_names + "'`");
+    }}
+
+    return result;
+}
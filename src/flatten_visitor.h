@@ -0,0 +1,253 @@
+#ifndef RJSONCONS_FLATTEN_VISITOR_H
+#define RJSONCONS_FLATTEN_VISITOR_H
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+
+#include "j_as.h"
+#include "path_buffer.h"
+
+#include <cpp11/integers.hpp>
+#include <cpp11/list.hpp>
+#include <cpp11/strings.hpp>
+
+using namespace jsoncons;
+using namespace cpp11;
+
+// Flatten a JSON document directly from parser events, without first
+// constructing the document. Each scalar (and each empty array or
+// object) is recorded with its JSONpointer or JSONpath path, as for
+// jsonpointer::flatten() / jsonpath::flatten(). Use with
+// json_string_reader or json_stream_reader; get_result() returns the
+// flattened document and resets the visitor for the next record.
+
+template<class Json>
+class flatten_visitor : public basic_json_visitor<char>
+{
+    struct frame {
+        bool is_array;
+        std::size_t index;      // next array index
+        std::size_t size;       // path_.size() at start of container
+        bool empty;
+    };
+
+    path_buffer path_;
+    std::vector<frame> stack_;
+    std::vector<std::pair<std::string, Json>> members_;
+
+    // add the array index of a new element to 'path_'; object keys are
+    // added by visit_key()
+    void begin_value()
+        {
+            if (stack_.empty())
+                return;
+            frame& parent = stack_.back();
+            parent.empty = false;
+            if (parent.is_array) {
+                path_.resize(parent.size);
+                path_.push_index(parent.index++);
+            }
+        }
+
+    bool scalar(Json&& value)
+        {
+            begin_value();
+            members_.emplace_back(path_.str(), std::move(value));
+            return true;
+        }
+
+    bool begin_container(bool is_array)
+        {
+            begin_value();
+            stack_.push_back({is_array, 0, path_.size(), true});
+            return true;
+        }
+
+    bool end_container()
+        {
+            const frame& current = stack_.back();
+            if (current.empty) {
+                path_.resize(current.size);
+                members_.emplace_back(
+                    path_.str(),
+                    current.is_array ?
+                        Json(json_array_arg) : Json(json_object_arg));
+            }
+            stack_.pop_back();
+            return true;
+        }
+
+    // basic_json_visitor
+
+    void visit_flush() override
+        {}
+
+    bool visit_begin_object(
+        semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return begin_container(false);
+        }
+
+    bool visit_end_object(const ser_context&, std::error_code&) override
+        {
+            return end_container();
+        }
+
+    bool visit_begin_array(
+        semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return begin_container(true);
+        }
+
+    bool visit_end_array(const ser_context&, std::error_code&) override
+        {
+            return end_container();
+        }
+
+    bool visit_key(
+        const string_view_type& name, const ser_context&,
+        std::error_code&) override
+        {
+            frame& parent = stack_.back();
+            parent.empty = false;
+            path_.resize(parent.size);
+            path_.push_key(name);
+            return true;
+        }
+
+    bool visit_null(
+        semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            return scalar(Json(null_type(), tag));
+        }
+
+    bool visit_bool(
+        bool value, semantic_tag tag, const ser_context&,
+        std::error_code&) override
+        {
+            return scalar(Json(value, tag));
+        }
+
+    bool visit_string(
+        const string_view_type& value, semantic_tag tag, const ser_context&,
+        std::error_code&) override
+        {
+            return scalar(Json(value, tag));
+        }
+
+    bool visit_byte_string(
+        const byte_string_view& value, semantic_tag tag, const ser_context&,
+        std::error_code&) override
+        {
+            return scalar(Json(byte_string_arg, value, tag));
+        }
+
+    bool visit_uint64(
+        uint64_t value, semantic_tag tag, const ser_context&,
+        std::error_code&) override
+        {
+            return scalar(Json(value, tag));
+        }
+
+    bool visit_int64(
+        int64_t value, semantic_tag tag, const ser_context&,
+        std::error_code&) override
+        {
+            return scalar(Json(value, tag));
+        }
+
+    bool visit_double(
+        double value, semantic_tag tag, const ser_context&,
+        std::error_code&) override
+        {
+            return scalar(Json(value, tag));
+        }
+
+public:
+    flatten_visitor(rjsoncons::path_type path_type)
+        : path_(path_type)
+        {}
+
+    Json get_result()
+        {
+            // a single bulk construction; for sorted 'json' objects
+            // this sorts once rather than on each insertion
+            Json result(
+                json_object_arg,
+                std::make_move_iterator(members_.begin()),
+                std::make_move_iterator(members_.end()));
+            reset();
+            return result;
+        }
+
+    // append paths and values, in document order, to 'paths' and
+    // 'values'
+    void get_result(std::vector<std::string>& paths, std::vector<Json>& values)
+        {
+            for (auto& member : members_) {
+                paths.push_back(std::move(member.first));
+                values.push_back(std::move(member.second));
+            }
+            reset();
+        }
+
+    void reset()
+        {
+            members_.clear();
+            stack_.clear();
+            path_.clear();
+        }
+};
+
+// Accumulate flattened records as columns 'record_id' (1-based),
+// 'path', and 'value', coerced to R in a single allocation per column.
+
+template<class Json>
+class flattened_columns
+{
+    int n_records_ = 0;
+    std::vector<int> record_id_;
+    std::vector<std::string> path_;
+    std::vector<Json> value_;
+
+public:
+    void append(flatten_visitor<Json>& visitor)
+        {
+            visitor.get_result(path_, value_);
+            record_id_.resize(path_.size(), ++n_records_);
+        }
+
+    sexp as_r(bool with_record_id) const
+        {
+            writable::list result(with_record_id ? 3 : 2);
+            writable::strings names(result.size());
+            R_xlen_t i = 0;
+
+            if (with_record_id) {
+                writable::integers record_id(record_id_.size());
+                std::copy(
+                    record_id_.cbegin(), record_id_.cend(), record_id.begin());
+                names[i] = "record_id";
+                result[i++] = record_id;
+            }
+
+            writable::strings path(path_.size());
+            for (std::size_t j = 0; j < path_.size(); ++j)
+                path[j] = path_[j];
+            names[i] = "path";
+            result[i++] = path;
+
+            names[i] = "value";
+            result[i] = j_as_r_column(value_);
+
+            result.names() = names;
+            return result;
+        }
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define RJSONCONS_J_AS_HPP
 
 #include <numeric>
+#include <vector>
 #include <jsoncons/json.hpp>
 
 using namespace jsoncons;
@@ -42,7 +43,7 @@ bool is_integer(Int64_t int64_value)
 }
 
 template<class Json>
-r_type r_atomic_type(const Json j)
+r_type r_atomic_type(const Json& j)
 {
     r_type rtype;
 
@@ -89,11 +90,11 @@ r_type r_atomic_type(const Json j)
 }
 
 template<class Json>
-r_type r_vector_type(const Json j)
+r_type r_vector_type(const Json& j)
 {
     r_type t;
 
-    auto array_type = [](r_type t, const Json j) {
+    auto array_type = [](r_type t, const Json& j) {
         r_type rt = r_atomic_type(j);
 
         // promotions
@@ -132,17 +133,17 @@ r_type r_vector_type(const Json j)
 }
 
 template<class Json, class cpp11_t, class json_t>
-sexp j_as_r_vector(const Json j)
+sexp j_as_r_vector(const Json& j)
 {
     cpp11_t value(j.size());
     std::transform(
         j.array_range().cbegin(), j.array_range().cend(), value.begin(),
-        [](const Json j_elt) { return j_elt.template as<json_t>(); });
+        [](const Json& j_elt) { return j_elt.template as<json_t>(); });
     return value;
 }
 
 template<class Json>
-sexp j_as_r(const Json j)
+sexp j_as_r(const Json& j)
 {
     sexp result;
     const r_type rtype = r_atomic_type(j);
@@ -196,7 +197,7 @@ sexp j_as_r(const Json j)
             const writable::list value(j.size());
             std::transform(
                 j.array_range().cbegin(), j.array_range().cend(), value.begin(),
-                [](const Json j_elt) { return j_as_r(j_elt); });
+                [](const Json& j_elt) { return j_as_r(j_elt); });
             result = value;
             break;
         }}
@@ -221,10 +222,102 @@ sexp j_as_r(const Json j)
     return result;
 }
 
+// type of an R column of 'values', e.g., from j_flatten(); unlike
+// r_vector_type(), 'null' is compatible with any type (as NA), and
+// arrays or objects (empty containers) require a list. 'Values' is
+// a std::vector<Json> or a JSON array
+template<class Values>
+r_type r_column_type(const Values& values)
+{
+    r_type t = r_type::null_value;
+
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        r_type rt = r_atomic_type(values[i]);
+        if (rt == r_type::null_value || rt == t)
+            continue;
+        if (rt == r_type::vector_value || rt == r_type::list_value)
+            return r_type::list_value;
+        if (t == r_type::null_value) {
+            t = rt;
+        } else if (
+            (t == r_type::integer_value || t == r_type::numeric_value) &&
+            (rt == r_type::integer_value || rt == r_type::numeric_value))
+        {
+            t = r_type::numeric_value;
+        } else {
+            return r_type::list_value;
+        }
+    }
+
+    return t;
+}
+
+template<class cpp11_t, class json_t, class Values>
+sexp j_as_r_column(const Values& values, const json_t na)
+{
+    cpp11_t column(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        column[i] = values[i].is_null() ?
+            na : values[i].template as<json_t>();
+    }
+    return column;
+}
+
+template<class Values>
+sexp j_as_r_column(const Values& values)
+{
+    sexp result;
+
+    switch(r_column_type(values)) {
+    case r_type::null_value:
+    case r_type::logical_value: {
+        // all 'null' values are NA
+        writable::logicals column(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            column[i] = values[i].is_null() ?
+                NA_LOGICAL : values[i].template as<bool>();
+        }
+        result = column;
+        break;
+    }
+    case r_type::integer_value: {
+        result = j_as_r_column<writable::integers, int32_t>(
+            values, NA_INTEGER);
+        break;
+    }
+    case r_type::numeric_value: {
+        result = j_as_r_column<writable::doubles, double>(
+            values, NA_REAL);
+        break;
+    }
+    case r_type::character_value: {
+        writable::strings column(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (values[i].is_null()) {
+                column[i] = NA_STRING;
+            } else {
+                column[i] = values[i].template as<std::string>();
+            }
+        }
+        result = column;
+        break;
+    }
+    case r_type::vector_value:
+    case r_type::list_value: {
+        writable::list column(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i)
+            column[i] = j_as_r(values[i]);
+        result = column;
+        break;
+    }}
+
+    return result;
+}
+
 // json to R
 
 template<class Json>
-sexp j_as(Json j, rjsoncons::as as)
+sexp j_as(const Json& j, rjsoncons::as as)
 {
     switch(as) {
     case as::string: return as_sexp( j.template as<std::string>() );
@@ -234,7 +327,7 @@ sexp j_as(Json j, rjsoncons::as as)
 }
 
 template<class Json>
-sexp j_as(Json j, const std::string& as)
+sexp j_as(const Json& j, const std::string& as)
 {
     return j_as(j, enum_index(as_map, as));
 }
@@ -0,0 +1,287 @@
+#ifndef RJSONCONS_J_FIND_H
+#define RJSONCONS_J_FIND_H
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+
+#include "enum_index.h"
+#include "path_buffer.h"
+
+#include <cpp11/doubles.hpp>
+#include <cpp11/function.hpp>
+#include <cpp11/list.hpp>
+#include <cpp11/logicals.hpp>
+#include <cpp11/sexp.hpp>
+#include <cpp11/strings.hpp>
+#include <cpp11/protect.hpp>    // 'stop'
+
+using namespace jsoncons;
+using namespace rjsoncons;
+using namespace cpp11;
+
+// j_find_keys(), j_find_values(), and the '_grep' variants: walk a
+// parsed record, building JSONpointer or JSONpath paths as for
+// j_flatten(), and return an object containing only matching path /
+// value pairs
+
+template<class Json>
+class j_find
+{
+    const rjsoncons::find_type find_type_;
+
+    // find_type::find_keys
+    std::unordered_set<std::string> keys_;
+
+    // find_type::find_values; 'values' from R as character and numeric
+    // vectors. Matches are a superset of R's `%in%`, which is applied
+    // to the (few) matching values in R
+    std::unordered_set<std::string> values_chr_;
+    std::vector<double> values_num_;
+    bool values_are_character_;
+
+    // find_type::*_grep; an R function(x) returning logical(),
+    // applied to batches of at most 'grep_batch_size' candidates so
+    // that memory does not grow with document size
+    sexp matcher_;
+    static const std::size_t grep_batch_size = 10000;
+
+    // walk state
+    path_buffer path_;
+    int n_key_matches_;     // matching keys in 'path_'
+    std::vector<std::pair<std::string, const Json*>> leaves_;
+
+    bool is_key_match(const std::string& key) const
+        {
+            return
+                find_type_ == find_type::find_keys &&
+                keys_.find(key) != keys_.end();
+        }
+
+    bool is_number_match(double x) const
+        {
+            for (const double value : values_num_) {
+                if (value == x) {
+                    return true;
+                } else if (values_are_character_ && !std::isnan(value)) {
+                    // R compares `as.character(x)` to character
+                    // 'values'; allow for R's 15 significant digits
+                    const double tol = 1e-14 * std::max(
+                        std::fabs(value), std::fabs(x));
+                    if (std::fabs(value - x) <= tol) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+    bool is_value_match(const Json& j) const
+        {
+            switch(j.type()) {
+            case json_type::string_value: {
+                const auto sv = j.as_string_view();
+                return
+                    values_chr_.find(std::string(sv.data(), sv.size())) !=
+                    values_chr_.end();
+            }
+            case json_type::bool_value: {
+                if (values_are_character_) {
+                    const std::string value = j.as_bool() ? "TRUE" : "FALSE";
+                    return values_chr_.find(value) != values_chr_.end();
+                }
+                return is_number_match(j.as_bool() ? 1 : 0);
+            }
+            case json_type::int64_value:
+            case json_type::uint64_value:
+            case json_type::double_value:
+                return is_number_match(j.template as<double>());
+            default:
+                // null, and empty arrays or objects, never match
+                return false;
+            }
+        }
+
+    void leaf(const Json& j, Json& result)
+        {
+            switch(find_type_) {
+            case find_type::find_keys: {
+                if (n_key_matches_ > 0)
+                    result.try_emplace(path_.str(), j);
+                break;
+            }
+            case find_type::find_values: {
+                if (is_value_match(j))
+                    result.try_emplace(path_.str(), j);
+                break;
+            }
+            case find_type::find_keys_grep: {
+                leaves_.emplace_back(path_.str(), &j);
+                break;
+            }
+            case find_type::find_values_grep: {
+                // only scalars are candidates
+                if (j.is_string() || j.is_bool() || j.is_number())
+                    leaves_.emplace_back(path_.str(), &j);
+                break;
+            }}
+            if (leaves_.size() == grep_batch_size)
+                grep(result);
+        }
+
+    void walk(const Json& j, Json& result)
+        {
+            const std::size_t size = path_.size();
+
+            switch(j.type()) {
+            case json_type::array_value: {
+                if (j.empty()) {
+                    leaf(j, result);
+                    break;
+                }
+                for (std::size_t i = 0; i < j.size(); ++i) {
+                    path_.push_index(i);
+                    const bool match = is_key_match(std::to_string(i));
+                    n_key_matches_ += match;
+                    walk(j.at(i), result);
+                    n_key_matches_ -= match;
+                    path_.resize(size);
+                }
+                break;
+            }
+            case json_type::object_value: {
+                if (j.empty()) {
+                    leaf(j, result);
+                    break;
+                }
+                for (const auto& member : j.object_range()) {
+                    const std::string key(member.key());
+                    path_.push_key(key);
+                    const bool match = is_key_match(key);
+                    n_key_matches_ += match;
+                    walk(member.value(), result);
+                    n_key_matches_ -= match;
+                    path_.resize(size);
+                }
+                break;
+            }
+            default: {
+                leaf(j, result);
+                break;
+            }}
+        }
+
+    // apply the R 'matcher_' once to the current batch of candidate
+    // leaves, then start a new batch
+    void grep(Json& result)
+        {
+            std::vector<std::size_t> idx;
+            std::vector<std::string> candidates;
+            std::vector<std::size_t> doubles_idx;
+            writable::doubles doubles;
+            for (std::size_t i = 0; i < leaves_.size(); ++i) {
+                const std::string& path = leaves_[i].first;
+                const Json& j = *leaves_[i].second;
+                if (find_type_ == find_type::find_keys_grep) {
+                    idx.push_back(i);
+                    candidates.push_back(path);
+                    continue;
+                }
+                // values_grep: candidates are scalar values, formatted
+                // as by `as.character()`
+                switch(j.type()) {
+                case json_type::string_value:
+                    idx.push_back(i);
+                    candidates.push_back(j.template as<std::string>());
+                    break;
+                case json_type::bool_value:
+                    idx.push_back(i);
+                    candidates.push_back(j.as_bool() ? "TRUE" : "FALSE");
+                    break;
+                case json_type::int64_value:
+                case json_type::uint64_value:
+                    idx.push_back(i);
+                    candidates.push_back(j.template as<std::string>());
+                    break;
+                case json_type::double_value:
+                    idx.push_back(i);
+                    doubles_idx.push_back(candidates.size());
+                    doubles.push_back(j.template as<double>());
+                    candidates.emplace_back();
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            if (doubles_idx.size()) {
+                // format doubles in a single call to R
+                const strings formatted(
+                    package("base")["as.character"](doubles));
+                for (std::size_t i = 0; i < doubles_idx.size(); ++i)
+                    candidates[doubles_idx[i]] = std::string(formatted[i]);
+            }
+
+            if (!candidates.empty()) {
+                const logicals hits(function(matcher_)(candidates));
+                for (std::size_t i = 0; i < idx.size(); ++i) {
+                    if (hits[i]) {
+                        const auto& leaf = leaves_[idx[i]];
+                        result.try_emplace(leaf.first, *leaf.second);
+                    }
+                }
+            }
+            leaves_.clear();
+        }
+
+public:
+    j_find(rjsoncons::find_type type, rjsoncons::path_type path_type, const sexp& target)
+        : find_type_(type),
+          values_are_character_(false),
+          path_(path_type), n_key_matches_(0)
+        {
+            switch(find_type_) {
+            case find_type::find_keys: {
+                for (const auto& key : strings(target))
+                    keys_.insert(std::string(key));
+                break;
+            }
+            case find_type::find_values: {
+                // list(as.character(values), as.numeric(values),
+                //      is.character(values))
+                const list values(target);
+                for (const auto& value : strings(values[0]))
+                    values_chr_.insert(std::string(value));
+                for (const double value : doubles(values[1]))
+                    values_num_.push_back(value);
+                values_are_character_ = logicals(values[2])[0];
+                break;
+            }
+            case find_type::find_keys_grep:
+            case find_type::find_values_grep: {
+                matcher_ = target;
+                break;
+            }}
+        }
+
+    Json find(const Json& j)
+        {
+            Json result(json_object_arg);
+            path_.clear();
+            n_key_matches_ = 0;
+            leaves_.clear();
+
+            walk(j, result);
+            if (!leaves_.empty())
+                grep(result);
+
+            return result;
+        }
+};
+
+#endif
@@ -0,0 +1,525 @@
+#ifndef RJSONCONS_JMESPATH_FASTPATH_H
+#define RJSONCONS_JMESPATH_FASTPATH_H
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+
+using namespace jsoncons;
+
+// Compile common JMESpath shapes to a small tree of specialized nodes
+// evaluated directly against the document, avoiding the jsoncons
+// token interpreter and its intermediate arrays. Supported shapes are
+//
+//   - `@` and field chains, e.g., `a.b."c"`
+//   - literals, e.g., `'a'` or `` `[1, 2]` `` (folded at compile time)
+//   - multiselect hashes and lists of the above, e.g., `{id: id, a: b.c}`
+//   - a single projection `base[*]`, `base[]`, or `base[?predicate]`,
+//     optionally followed by `.chain`, `.{...}` or `.[...]`; filter,
+//     projection and field access are fused into one pass
+//
+// Predicates are comparisons (`==`, `!=`, `<`, `<=`, `>`, `>=`) or
+// operands combined with `&&` and `||`; comparisons between literals
+// are folded. Anything else is reported as unsupported, and the caller
+// uses the jsoncons interpreter.
+
+template<class Json>
+class jmespath_fastpath
+{
+    enum class kind : uint8_t {
+        identity, constant, field, hash, list, projection,
+        compare, and_op, or_op
+    };
+    enum class projection_kind : uint8_t { wildcard, flatten, filter };
+    enum class comparator : uint8_t { eq, ne, lt, lte, gt, gte };
+
+    // nodes are stored in a flat pool and refer to each other by index
+    struct node {
+        kind kind_;
+        Json constant_;                 // kind::constant
+        std::vector<std::string> keys_; // kind::field path; kind::hash keys
+        std::vector<std::size_t> children_;
+        projection_kind projection_;    // kind::projection
+        comparator comparator_;         // kind::compare
+    };
+
+    std::vector<node> nodes_;
+    std::size_t root_;
+    bool supported_;
+    const Json null_;
+
+    // parser state
+    const std::string expr_;
+    std::size_t pos_;
+
+    // parsing
+
+    struct unsupported {};      // thrown to abandon compilation
+
+    std::size_t add(node n)
+        {
+            nodes_.push_back(std::move(n));
+            return nodes_.size() - 1;
+        }
+
+    std::size_t add(kind k)
+        {
+            node n;
+            n.kind_ = k;
+            return add(std::move(n));
+        }
+
+    void skip_ws()
+        {
+            while (pos_ < expr_.size() && std::isspace(
+                       static_cast<unsigned char>(expr_[pos_])))
+                ++pos_;
+        }
+
+    bool at_end()
+        {
+            skip_ws();
+            return pos_ == expr_.size();
+        }
+
+    char peek()
+        {
+            skip_ws();
+            return pos_ < expr_.size() ? expr_[pos_] : '\0';
+        }
+
+    bool accept(const char* token)
+        {
+            skip_ws();
+            const std::size_t n = std::char_traits<char>::length(token);
+            if (expr_.compare(pos_, n, token) != 0)
+                return false;
+            pos_ += n;
+            return true;
+        }
+
+    void expect(const char* token)
+        {
+            if (!accept(token))
+                throw unsupported();
+        }
+
+    static bool is_identifier_start(char c)
+        {
+            return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+        }
+
+    static bool is_identifier_char(char c)
+        {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+        }
+
+    // text up to the closing 'delimiter'; expressions with escapes are
+    // left to the jsoncons interpreter
+    std::string delimited(char delimiter)
+        {
+            const std::size_t start = ++pos_;
+            while (pos_ < expr_.size() && expr_[pos_] != delimiter) {
+                if (expr_[pos_] == '\\')
+                    throw unsupported();
+                ++pos_;
+            }
+            if (pos_ == expr_.size())
+                throw unsupported();
+            return expr_.substr(start, pos_++ - start);
+        }
+
+    std::string identifier()
+        {
+            const char c = peek();
+            if (c == '"')
+                return delimited('"');
+            if (!is_identifier_start(c))
+                throw unsupported();
+            const std::size_t start = pos_;
+            while (pos_ < expr_.size() && is_identifier_char(expr_[pos_]))
+                ++pos_;
+            return expr_.substr(start, pos_ - start);
+        }
+
+    std::size_t literal()
+        {
+            node n;
+            n.kind_ = kind::constant;
+            if (peek() == '\'') {
+                n.constant_ = Json(delimited('\''));
+            } else {
+                try {
+                    n.constant_ = Json::parse(delimited('`'));
+                } catch (const ser_error&) {
+                    throw unsupported();
+                }
+            }
+            return add(std::move(n));
+        }
+
+    // `@`, `@.a.b`, or `a.b`; 'relative' chains follow a `.`
+    std::size_t chain(bool relative)
+        {
+            node n;
+            n.kind_ = kind::field;
+            if (!relative && accept("@")) {
+                if (peek() != '.')
+                    return add(kind::identity);
+                expect(".");
+            }
+            n.keys_.push_back(identifier());
+            while (peek() == '.') {
+                const std::size_t mark = pos_;
+                expect(".");
+                const char c = peek();
+                if (!(c == '"' || is_identifier_start(c))) {
+                    // e.g., `a.{...}`; leave the '.' for the caller
+                    pos_ = mark;
+                    break;
+                }
+                n.keys_.push_back(identifier());
+            }
+            return add(std::move(n));
+        }
+
+    // a chain or literal
+    std::size_t operand()
+        {
+            const char c = peek();
+            if (c == '\'' || c == '`')
+                return literal();
+            return chain(false);
+        }
+
+    std::size_t multiselect_hash()
+        {
+            node n;
+            n.kind_ = kind::hash;
+            expect("{");
+            do {
+                n.keys_.push_back(identifier());
+                expect(":");
+                n.children_.push_back(operand());
+            } while (accept(","));
+            expect("}");
+            return add(std::move(n));
+        }
+
+    std::size_t multiselect_list()
+        {
+            node n;
+            n.kind_ = kind::list;
+            expect("[");
+            do {
+                n.children_.push_back(operand());
+            } while (accept(","));
+            expect("]");
+            return add(std::move(n));
+        }
+
+    std::size_t comparison()
+        {
+            const std::size_t lhs = operand();
+            static const std::vector<std::pair<const char*, comparator>> ops {
+                {"==", comparator::eq}, {"!=", comparator::ne},
+                {"<=", comparator::lte}, {">=", comparator::gte},
+                {"<", comparator::lt}, {">", comparator::gt}
+            };
+            for (const auto& op : ops) {
+                if (accept(op.first)) {
+                    node n;
+                    n.kind_ = kind::compare;
+                    n.comparator_ = op.second;
+                    n.children_ = { lhs, operand() };
+                    return fold(add(std::move(n)));
+                }
+            }
+            return lhs;
+        }
+
+    std::size_t conjunction(std::size_t (jmespath_fastpath::*term)(), kind k,
+                            const char* token)
+        {
+            std::size_t lhs = (this->*term)();
+            while (accept(token)) {
+                node n;
+                n.kind_ = k;
+                n.children_ = { lhs, (this->*term)() };
+                lhs = fold(add(std::move(n)));
+            }
+            return lhs;
+        }
+
+    std::size_t and_expression()
+        {
+            return conjunction(
+                &jmespath_fastpath::comparison, kind::and_op, "&&");
+        }
+
+    std::size_t predicate()
+        {
+            return conjunction(
+                &jmespath_fastpath::and_expression, kind::or_op, "||");
+        }
+
+    // replace predicates on constants by their (constant) value
+    std::size_t fold(std::size_t i)
+        {
+            const node& n = nodes_[i];
+            for (auto child : n.children_) {
+                if (nodes_[child].kind_ != kind::constant)
+                    return i;
+            }
+            node folded;
+            folded.kind_ = kind::constant;
+            folded.constant_ = Json(evaluate(i, null_));
+            return add(std::move(folded));
+        }
+
+    // projections are `base[*]`, `base[]`, or `base[?predicate]`, with
+    // an optional right-hand side applied to each selected element;
+    // `[*]`, `[]` and `[?` are single tokens without whitespace
+    std::size_t projection(std::size_t base)
+        {
+            node n;
+            n.kind_ = kind::projection;
+            expect("[");
+            std::size_t filter = 0;
+            if (expr_.compare(pos_, 2, "*]") == 0) {
+                n.projection_ = projection_kind::wildcard;
+                pos_ += 2;
+            } else if (expr_.compare(pos_, 1, "]") == 0) {
+                n.projection_ = projection_kind::flatten;
+                pos_ += 1;
+            } else if (expr_.compare(pos_, 1, "?") == 0) {
+                n.projection_ = projection_kind::filter;
+                pos_ += 1;
+                filter = predicate();
+                expect("]");
+            } else {
+                throw unsupported();
+            }
+
+            std::size_t rhs = add(kind::identity);
+            if (accept(".")) {
+                const char c = peek();
+                if (c == '{') {
+                    rhs = multiselect_hash();
+                } else if (c == '[') {
+                    rhs = multiselect_list();
+                } else {
+                    rhs = chain(true);
+                }
+            }
+            n.children_ = { base, rhs, filter };
+            return add(std::move(n));
+        }
+
+    std::size_t expression()
+        {
+            const char c = peek();
+            if (c == '{')
+                return multiselect_hash();
+            if (c == '\'' || c == '`')
+                return literal();
+
+            std::size_t base;
+            if (c == '[') {
+                // `[*]`, `[]`, `[?` project the current node; otherwise
+                // a multiselect list
+                const char next =
+                    pos_ + 1 < expr_.size() ? expr_[pos_ + 1] : '\0';
+                if (next != '*' && next != ']' && next != '?')
+                    return multiselect_list();
+                base = add(kind::identity);
+            } else {
+                base = chain(false);
+            }
+
+            return peek() == '[' ? projection(base) : base;
+        }
+
+    // evaluation
+
+    // resolve identity, field, and constant nodes without copying
+    const Json& resolve(std::size_t i, const Json& current) const
+        {
+            const node& n = nodes_[i];
+            switch(n.kind_) {
+            case kind::identity: return current;
+            case kind::constant: return n.constant_;
+            case kind::field: {
+                const Json* value = &current;
+                for (const auto& key : n.keys_) {
+                    if (!value->is_object())
+                        return null_;
+                    auto it = value->find(key);
+                    if (it == value->object_range().end())
+                        return null_;
+                    value = &it->value();
+                }
+                return *value;
+            }
+            default: return null_;
+            }
+        }
+
+    bool compare(const node& n, const Json& current) const
+        {
+            const Json& lhs = resolve(n.children_[0], current);
+            const Json& rhs = resolve(n.children_[1], current);
+            switch(n.comparator_) {
+            case comparator::eq: return lhs == rhs;
+            case comparator::ne: return lhs != rhs;
+            default: break;
+            }
+            // ordering comparisons are only defined for numbers
+            if (!(lhs.is_number() && rhs.is_number()))
+                return false;
+            switch(n.comparator_) {
+            case comparator::lt: return lhs < rhs;
+            case comparator::lte: return lhs <= rhs;
+            case comparator::gt: return lhs > rhs;
+            case comparator::gte: return lhs >= rhs;
+            default: return false;
+            }
+        }
+
+    bool is_true(std::size_t i, const Json& current) const
+        {
+            const node& n = nodes_[i];
+            switch(n.kind_) {
+            case kind::compare: return compare(n, current);
+            case kind::and_op:
+                return
+                    is_true(n.children_[0], current) &&
+                    is_true(n.children_[1], current);
+            case kind::or_op:
+                return
+                    is_true(n.children_[0], current) ||
+                    is_true(n.children_[1], current);
+            default: return !is_false(resolve(i, current));
+            }
+        }
+
+    // apply the projection right-hand side to 'elt', appending non-null
+    // results to 'result'
+    void project(std::size_t rhs, const Json& elt, Json& result) const
+        {
+            const node& n = nodes_[rhs];
+            if (n.kind_ == kind::identity || n.kind_ == kind::field) {
+                const Json& value = resolve(rhs, elt);
+                if (!value.is_null())
+                    result.push_back(value);
+            } else {
+                Json value = evaluate(rhs, elt);
+                if (!value.is_null())
+                    result.push_back(std::move(value));
+            }
+        }
+
+    Json evaluate_projection(const node& n, const Json& current) const
+        {
+            const Json& base = resolve(n.children_[0], current);
+            if (!base.is_array())
+                return Json::null();
+
+            const std::size_t rhs = n.children_[1];
+            Json result(json_array_arg);
+            for (const auto& elt : base.array_range()) {
+                switch(n.projection_) {
+                case projection_kind::wildcard:
+                    project(rhs, elt, result);
+                    break;
+                case projection_kind::filter:
+                    if (is_true(n.children_[2], elt))
+                        project(rhs, elt, result);
+                    break;
+                case projection_kind::flatten:
+                    if (elt.is_array()) {
+                        for (const auto& inner : elt.array_range())
+                            project(rhs, inner, result);
+                    } else {
+                        project(rhs, elt, result);
+                    }
+                    break;
+                }
+            }
+            return result;
+        }
+
+    Json evaluate(std::size_t i, const Json& current) const
+        {
+            const node& n = nodes_[i];
+            switch(n.kind_) {
+            case kind::identity:
+            case kind::constant:
+            case kind::field:
+                return resolve(i, current);
+            case kind::hash: {
+                if (current.is_null())
+                    return Json::null();
+                Json result(json_object_arg);
+                for (std::size_t k = 0; k < n.keys_.size(); ++k)
+                    result.insert_or_assign(
+                        n.keys_[k], resolve(n.children_[k], current));
+                return result;
+            }
+            case kind::list: {
+                if (current.is_null())
+                    return Json::null();
+                Json result(json_array_arg);
+                result.reserve(n.children_.size());
+                for (auto child : n.children_)
+                    result.push_back(resolve(child, current));
+                return result;
+            }
+            case kind::projection:
+                return evaluate_projection(n, current);
+            default:
+                return Json(is_true(i, current));
+            }
+        }
+
+public:
+    jmespath_fastpath(const std::string& expr)
+        : root_(0), supported_(false), null_(Json::null()),
+          expr_(expr), pos_(0)
+        {
+            try {
+                root_ = expression();
+                supported_ = at_end();
+            } catch (const unsupported&) {
+                supported_ = false;
+            }
+            if (!supported_)
+                nodes_.clear();
+        }
+
+    bool supported() const
+        {
+            return supported_;
+        }
+
+    Json evaluate(const Json& j) const
+        {
+            return evaluate(root_, j);
+        }
+
+    // JMESpath truthiness: null, false, and empty strings, arrays, and
+    // objects are false
+    static bool is_false(const Json& j)
+        {
+            return
+                (j.is_array() && j.empty()) ||
+                (j.is_object() && j.empty()) ||
+                (j.is_string() && j.as_string_view().size() == 0) ||
+                (j.is_bool() && !j.as_bool()) ||
+                j.is_null();
+        }
+};
+
+#endif
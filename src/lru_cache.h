@@ -0,0 +1,64 @@
+#ifndef RJSONCONS_LRU_CACHE_H
+#define RJSONCONS_LRU_CACHE_H
+
+#include <list>
+#include <map>
+#include <memory>
+#include <utility>
+
+// A small least-recently-used cache of shared objects. Values are
+// created on first use by a 'make' function; when full, the least
+// recently used entry is evicted. Values are held by shared_ptr so
+// that entries in use survive eviction. Not thread-safe; use only
+// from the main R thread.
+
+template<class Key, class Value>
+class lru_cache
+{
+    using entry = std::pair<Key, std::shared_ptr<Value>>;
+
+    const std::size_t capacity_;
+    std::list<entry> entries_;  // most recently used first
+    std::map<Key, typename std::list<entry>::iterator> index_;
+
+public:
+    lru_cache(std::size_t capacity)
+        : capacity_(capacity)
+        {}
+
+    template<class Make>
+    std::shared_ptr<Value> get(const Key& key, Make make)
+        {
+            auto it = index_.find(key);
+            if (it != index_.end()) {
+                // move to front
+                entries_.splice(entries_.begin(), entries_, it->second);
+                return it->second->second;
+            }
+
+            // 'make()' may throw, e.g., on an invalid path; nothing is
+            // inserted in that case
+            std::shared_ptr<Value> value = make();
+            entries_.emplace_front(key, value);
+            index_[key] = entries_.begin();
+            if (entries_.size() > capacity_) {
+                index_.erase(entries_.back().first);
+                entries_.pop_back();
+            }
+
+            return value;
+        }
+
+    std::size_t size() const
+        {
+            return entries_.size();
+        }
+
+    void clear()
+        {
+            index_.clear();
+            entries_.clear();
+        }
+};
+
+#endif
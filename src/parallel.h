@@ -0,0 +1,34 @@
+#ifndef RJSONCONS_PARALLEL_H
+#define RJSONCONS_PARALLEL_H
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// Apply f(begin, end, thread) to 'n_threads' contiguous ranges
+// partitioning [0, n); range 0 runs on the calling thread. 'f' must
+// not call the R API (including cpp11::stop()) or throw.
+
+template<class F>
+void parallel_for(std::size_t n, std::size_t n_threads, F f)
+{
+    n_threads = std::max(std::min(n_threads, n), std::size_t(1));
+    if (n_threads == 1) {
+        f(std::size_t(0), n, std::size_t(0));
+        return;
+    }
+
+    const std::size_t chunk = (n + n_threads - 1) / n_threads;
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads - 1);
+    for (std::size_t t = 1; t < n_threads; ++t) {
+        const std::size_t begin = std::min(t * chunk, n);
+        const std::size_t end = std::min(begin + chunk, n);
+        threads.emplace_back(f, begin, end, t);
+    }
+    f(std::size_t(0), std::min(chunk, n), std::size_t(0));
+    for (auto& thread : threads)
+        thread.join();
+}
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef RJSONCONS_PATH_BUFFER_H
+#define RJSONCONS_PATH_BUFFER_H
+
+#include <string>
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/jsonpath/jsonpath_utilities.hpp>
+#include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
+
+#include "enum_index.h"
+
+#include <cpp11/protect.hpp>    // 'stop'
+
+using namespace jsoncons;
+using namespace rjsoncons;
+
+// A JSONpointer or JSONpath path built one key or index at a time, in
+// the format of jsonpointer::flatten() / jsonpath::flatten(). Callers
+// record size() before pushing a segment and resize() to pop it.
+
+class path_buffer
+{
+    const rjsoncons::path_type path_type_;
+    std::string path_;
+
+public:
+    path_buffer(rjsoncons::path_type path_type)
+        : path_type_(path_type)
+        {
+            if (path_type_ == path_type::JMESpath)
+                cpp11::stop("unsupported 'path_type' JMESpath");
+            clear();
+        }
+
+    void clear()
+        {
+            path_ = path_type_ == path_type::JSONpointer ? "" : "$";
+        }
+
+    void push_key(const jsoncons::string_view& key)
+        {
+            if (path_type_ == path_type::JSONpointer) {
+                path_.push_back('/');
+                jsonpointer::escape(key, path_);
+            } else {
+                path_.append("['");
+                jsonpath::escape_string(key.data(), key.size(), path_);
+                path_.append("']");
+            }
+        }
+
+    void push_index(std::size_t i)
+        {
+            if (path_type_ == path_type::JSONpointer) {
+                path_.push_back('/');
+                jsoncons::detail::from_integer(i, path_);
+            } else {
+                path_.push_back('[');
+                jsoncons::detail::from_integer(i, path_);
+                path_.push_back(']');
+            }
+        }
+
+    std::size_t size() const
+        {
+            return path_.size();
+        }
+
+    void resize(std::size_t size)
+        {
+            path_.resize(size);
+        }
+
+    const std::string& str() const
+        {
+            return path_;
+        }
+};
+
+#endif
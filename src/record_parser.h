@@ -0,0 +1,51 @@
+#ifndef RJSONCONS_RECORD_PARSER_H
+#define RJSONCONS_RECORD_PARSER_H
+
+#include <string>
+
+#include <jsoncons/json.hpp>
+
+using namespace jsoncons;
+
+// Parse many small documents, e.g., NDJSON records, one after
+// another, reusing the buffers of one parser and decoder rather than
+// allocating them for each record as ojson::parse() does. Errors are
+// thrown as for ojson::parse(). Not thread-safe; use one per thread.
+
+class record_parser
+{
+    json_parser parser_;
+    json_decoder<ojson> decoder_;
+
+public:
+    // send the events of 'record' to 'visitor'
+    void parse(const std::string& record, basic_json_visitor<char>& visitor)
+        {
+            parser_.reinitialize();
+            auto r = unicode_traits::detect_encoding_from_bom(
+                record.data(), record.size());
+            if (!(r.encoding == unicode_traits::encoding_kind::utf8 ||
+                  r.encoding == unicode_traits::encoding_kind::undetected))
+                JSONCONS_THROW(ser_error(
+                    json_errc::illegal_unicode_character,
+                    parser_.line(), parser_.column()));
+            const std::size_t offset = r.ptr - record.data();
+            parser_.update(record.data() + offset, record.size() - offset);
+            parser_.parse_some(visitor);
+            parser_.finish_parse(visitor);
+            parser_.check_done();
+            // e.g., an empty record
+            if (!parser_.done())
+                JSONCONS_THROW(ser_error(
+                    json_errc::source_error, "Failed to parse json string"));
+        }
+
+    ojson parse(const std::string& record)
+        {
+            decoder_.reset();
+            parse(record, decoder_);
+            return decoder_.get_result();
+        }
+};
+
+#endif
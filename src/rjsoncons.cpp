@@ -77,19 +77,23 @@ sexp cpp_as_r_con(
 sexp cpp_j_query(
     const std::vector<std::string>& data, const std::string& data_type,
     const std::string& object_names, const std::string& as,
-    const std::string& path, const std::string& path_type)
+    const std::string& path, const std::string& path_type,
+    const std::string& filter, const std::string& filter_type,
+    const std::vector<std::string>& prefilter)
 {
     sexp result;
     switch(enum_index(object_names_map, object_names)) {
     case object_names::asis: {
         result =
             rquerypivot<ojson>(path, as, data_type, path_type, false).
+            filter(filter, filter_type).prefilter(prefilter).
             query(data);
         break;
     }
     case object_names::sort: {
         result =
             rquerypivot<json>(path, as, data_type, path_type, false).
+            filter(filter, filter_type).prefilter(prefilter).
             query(data);
         break;
     }
@@ -105,6 +109,8 @@ sexp cpp_j_query_con(
     const sexp& con, const std::string& data_type,
     const std::string& object_names, const std::string& as,
     const std::string& path, const std::string& path_type,
+    const std::string& filter, const std::string& filter_type,
+    const std::vector<std::string>& prefilter,
     const double n_records, const bool verbose)
 {
     sexp result;
@@ -112,12 +118,14 @@ sexp cpp_j_query_con(
     case object_names::asis: {
         result =
             rquerypivot<ojson>(path, as, data_type, path_type, verbose).
+            filter(filter, filter_type).prefilter(prefilter).
             query(con, n_records);
         break;
     }
     case object_names::sort: {
         result =
             rquerypivot<json>(path, as, data_type, path_type, verbose).
+            filter(filter, filter_type).prefilter(prefilter).
             query(con, n_records);
         break;
     }
@@ -128,26 +136,93 @@ sexp cpp_j_query_con(
     return result;
 }
 
+// j_query_multi
+
+[[cpp11::register]]
+sexp cpp_j_query_multi(
+    const std::vector<std::string>& data, const std::string& data_type,
+    const std::string& object_names, const std::string& as,
+    const std::vector<std::string>& paths,
+    const std::vector<std::string>& path_types)
+{
+    sexp result;
+    switch(enum_index(object_names_map, object_names)) {
+    case object_names::asis: {
+        result =
+            rquerypivot<ojson>(paths, path_types, as, data_type, false).
+            query_multi(data);
+        break;
+    }
+    case object_names::sort: {
+        result =
+            rquerypivot<json>(paths, path_types, as, data_type, false).
+            query_multi(data);
+        break;
+    }
+    default: {
+        cpp11::stop("unknown `object_names = '" + object_names + "'`");
+    }}
+
+    return result;
+}
+
+[[cpp11::register]]
+sexp cpp_j_query_multi_con(
+    const sexp& con, const std::string& data_type,
+    const std::string& object_names, const std::string& as,
+    const std::vector<std::string>& paths,
+    const std::vector<std::string>& path_types,
+    const double n_records, const bool verbose)
+{
+    sexp result;
+    switch(enum_index(object_names_map, object_names)) {
+    case object_names::asis: {
+        result =
+            rquerypivot<ojson>(paths, path_types, as, data_type, verbose).
+            query_multi(con, n_records);
+        break;
+    }
+    case object_names::sort: {
+        result =
+            rquerypivot<json>(paths, path_types, as, data_type, verbose).
+            query_multi(con, n_records);
+        break;
+    }
+    default: {
+        cpp11::stop("unknown `object_names = '" + object_names + "'`");
+    }}
+
+    return result;
+}
+
 // j_pivot
 
 [[cpp11::register]]
 sexp cpp_j_pivot(
     const std::vector<std::string>& data, const std::string& data_type,
     const std::string& object_names, const std::string& as,
-    const std::string& path, const std::string& path_type)
+    const std::string& path, const std::string& path_type,
+    const std::string& filter, const std::string& filter_type,
+    const std::vector<std::string>& prefilter, const int threads,
+    const std::string& unnest, const std::vector<std::string>& col_names,
+    const std::vector<std::string>& col_types)
 {
     sexp result;
     switch(enum_index(object_names_map, object_names)) {
     case object_names::asis: {
         result =
             rquerypivot<ojson>(path, as, data_type, path_type, false).
-            pivot(data);
+            filter(filter, filter_type).prefilter(prefilter).
+            threads(threads).unnest(unnest).
+            col_types(col_names, col_types).pivot(data);
         break;
     }
     case object_names::sort: {
         result =
             rquerypivot<json>(path, as, data_type, path_type, false).
-            pivot(data);
+            filter(filter, filter_type).prefilter(prefilter).
+            threads(threads).unnest(unnest).
+            col_types(col_names, col_types).pivot(data);
         break;
     }
     default: {
@@ -162,6 +237,10 @@ sexp cpp_j_pivot_con(
     const sexp& con, const std::string& data_type,
     const std::string& object_names, const std::string& as,
     const std::string& path, const std::string& path_type,
+    const std::string& filter, const std::string& filter_type,
+    const std::vector<std::string>& prefilter, const int threads,
+    const std::string& unnest, const std::vector<std::string>& col_names,
+    const std::vector<std::string>& col_types,
     const double n_records, const bool verbose)
 {
     sexp result;
@@ -169,13 +248,17 @@ sexp cpp_j_pivot_con(
     case object_names::asis: {
         result =
             rquerypivot<ojson>(path, as, data_type, path_type, verbose).
-            pivot(con, n_records);
+            filter(filter, filter_type).prefilter(prefilter).
+            threads(threads).unnest(unnest).
+            col_types(col_names, col_types).pivot(con, n_records);
         break;
     }
     case object_names::sort: {
         result =
             rquerypivot<json>(path, as, data_type, path_type, verbose).
-            pivot(con, n_records);
+            filter(filter, filter_type).prefilter(prefilter).
+            threads(threads).unnest(unnest).
+            col_types(col_names, col_types).pivot(con, n_records);
         break;
     }
     default: {
@@ -2,15 +2,23 @@
 #define RJSONCONS_R_JSON_HPP
 
 #include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <jsoncons/json.hpp>
-#include <jsoncons_ext/jmespath/jmespath.hpp>
 #include <jsoncons_ext/jsonpath/jsonpath.hpp>
 #include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
 
 #include "readbinbuf.h"
 #include "progressbar.h"
 #include "j_as.h"
+#include "compiled_path.h"
+#include "j_find.h"
+#include "flatten_visitor.h"
+#include "unflatten.h"
+#include "parallel.h"
+#include "typed_columns.h"
 
 #include <cpp11/sexp.hpp>
 #include <cpp11/list.hpp>
@@ -26,38 +34,67 @@ class rquerypivot
     const rjsoncons::as as_;
     const rjsoncons::data_type data_type_;
     const rjsoncons::path_type path_type_;
-    // only one of the following will be valid per instance
-    jmespath::jmespath_expression<Json> jmespath_;
-    jsonpath::jsonpath_expression<Json> jsonpath_;
-    const std::string jsonpointer_;
+    // shared with the compiled path cache; null when no path is needed
+    std::shared_ptr<compiled_path<Json>> path_;
+    // several paths evaluated in a single pass over 'data'; result_
+    // holds paths_.size() results per record, in path order
+    std::vector<std::shared_ptr<compiled_path<Json>>> paths_;
+    // optional record-level predicate; records for which it is false
+    // are not passed to the transform
+    std::shared_ptr<compiled_path<Json>> filter_;
+    // optional substrings that must all occur in a raw NDJSON line
+    // before it is parsed
+    std::vector<std::string> prefilter_;
+    // j_find_*(); null except during find()
+    std::unique_ptr<j_find<Json>> find_;
+    // j_flatten(as = "data.frame") / j_flatten(as = "tibble")
+    flattened_columns<Json> columns_;
+    // j_unflatten(); null except during unflatten()
+    std::unique_ptr<unflattener<Json>> unflatten_;
+
+    // threads used by pivot_json_array()
+    std::size_t threads_ = 1;
+    // pivot_ndjson() and pivot_unnest() append rows to columns of
+    // result_[0]; 'pivot_columns_' are handles to the columns,
+    // refreshed when a new key is added; 'pivot_index_' maps keys to
+    // handles
+    std::vector<Json*> pivot_columns_;
+    std::vector<std::string> pivot_keys_;
+    std::unordered_map<std::string, std::size_t> pivot_index_;
+    std::vector<std::size_t> pivot_hint_;
+    std::size_t pivot_rows_ = 0;
+    // j_pivot(unnest = ); the record member whose array elements
+    // become rows, or "" to pivot records as-is
+    std::string unnest_;
+    // j_pivot(col_types = ); rows are added to typed_ rather than
+    // result_; null unless column types are declared
+    std::unique_ptr<typed_columns<Json>> typed_;
 
     bool verbose_;
     std::vector<Json> result_;
 
     // query implementation
 
-    Json query(Json j)
+    // move rather than copy a record selected in full
+    Json query(Json&& j)
         {
-            switch(path_type_) {
-            case path_type::JSONpointer:
-                return jsonpointer::get<Json>(j, jsonpointer_);
-            case path_type::JSONpath: return jsonpath_.evaluate(j);
-            case path_type::JMESpath: return jmespath_.evaluate(j);
-            default: cpp11::stop("`j_query()` unknown 'path_type'");
-            }
+            return path_->is_identity() ? std::move(j) : path_->evaluate(j);
         }
 
     // pivot implementation
 
-    std::vector<std::string> pivot_json_all_keys(const Json j)
+    // keys of objects in j[begin, end), in the order they are
+    // discovered
+    std::vector<std::string> pivot_json_keys(
+        const Json& j, std::size_t begin, std::size_t end) const
         {
-            // 'keys' returns keys in the order they are discoverd, 'seen' is
-            // used as a filter to only insert unseen keys
+            // 'seen' is used as a filter to only insert unseen keys
             std::vector<std::string> keys;
             std::unordered_set<std::string> seen;
 
             // visit each element in the array...
-            for (const auto& elt : j.array_range()) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const Json& elt = j[i];
                 // if it's an object...
                 if (elt.type() != json_type::object_value) {
                     continue;
@@ -73,29 +110,71 @@ class rquerypivot
             return keys;
         }
 
-    Json pivot_json_array(const Json j)
+    // pivot an array-of-objects to an object-of-arrays, moving values
+    // from 'j'. Rows are partitioned across threads_ threads, first to
+    // discover keys (merged in row order) and then to fill disjoint
+    // rows of pre-sized columns.
+    Json pivot_json_array(Json& j)
         {
-            Json object(json_object_arg);
-            const std::vector<std::string> keys = pivot_json_all_keys(j);
+            const std::size_t n = j.size();
+            // small arrays are not worth a thread
+            const std::size_t n_threads =
+                std::min(threads_, std::max(n / 10000, std::size_t(1)));
+
+            std::vector<std::vector<std::string>> thread_keys(n_threads);
+            parallel_for(n, n_threads, [&](
+                std::size_t begin, std::size_t end, std::size_t t)
+            {
+                thread_keys[t] = pivot_json_keys(j, begin, end);
+            });
 
-            // initialize
-            for (const auto& key : keys) {
-                object[key] = Json(json_array_arg);
+            std::vector<std::string> keys;
+            std::unordered_map<std::string, std::size_t> column_index;
+            for (const auto& some_keys : thread_keys) {
+                for (const auto& key : some_keys) {
+                    if (column_index.emplace(key, keys.size()).second)
+                        keys.push_back(key);
+                }
             }
 
-            // pivot
-            for (const auto& elt : j.array_range()) {
-                for (const auto& key : keys) {
-                    // non-object values or missing elements are assigned 'null'
-                    Json value = Json::null();
-                    if (elt.type() == json_type::object_value) {
-                        value = elt.at_or_null(key);
+            // non-object values or missing elements are 'null'
+            std::vector<Json> columns(keys.size(), Json(json_array_arg));
+            for (auto& column : columns)
+                column.resize(n, Json::null());
+
+            parallel_for(n, n_threads, [&](
+                std::size_t begin, std::size_t end, std::size_t)
+            {
+                // column of each member position in the previous
+                // object; objects often share keys in the same order
+                std::vector<std::size_t> hint;
+                for (std::size_t i = begin; i < end; ++i) {
+                    Json& elt = j[i];
+                    if (elt.type() != json_type::object_value)
+                        continue;
+                    std::size_t position = 0;
+                    for (auto& member : elt.object_range()) {
+                        if (position == hint.size()) {
+                            hint.push_back(
+                                column_index.find(member.key())->second);
+                        } else if (keys[hint[position]] != member.key()) {
+                            hint[position] =
+                                column_index.find(member.key())->second;
+                        }
+                        columns[hint[position]][i] = std::move(member.value());
+                        ++position;
                     }
-                    object[key].push_back(value);
                 }
-            }
+            });
+
+            // insert columns one at a time; the range constructor of
+            // sorted ('json') objects copies values, even when moved
+            Json result(json_object_arg);
+            result.reserve(keys.size());
+            for (std::size_t k = 0; k < keys.size(); ++k)
+                result.try_emplace(keys[k], std::move(columns[k]));
 
-            return object;
+            return result;
         }
 
     void pivot_json(Json j)
@@ -108,10 +187,12 @@ class rquerypivot
             case json_type::object_value: {
                 // all members of 'j' need to be JSON array
                 for (auto& member: j.object_range()) {
-                    auto key = member.key();
-                    if (member.value().type() != json_type::array_value) {
-                        Json ja = Json::make_array(1, j[key]);
-                        j[key].swap(ja);
+                    Json& value = member.value();
+                    if (value.type() != json_type::array_value) {
+                        Json ja(json_array_arg);
+                        ja.reserve(1);
+                        ja.push_back(std::move(value));
+                        value = std::move(ja);
                     }
                 }
                 break;
@@ -125,9 +206,91 @@ class rquerypivot
             }}
 
 
-            result_.push_back(j);
+            result_.push_back(std::move(j));
+        }
+
+    std::size_t pivot_ndjson_column(Json& result, const std::string& key)
+        {
+            auto it = pivot_index_.find(key);
+            if (it != pivot_index_.end())
+                return it->second;
+
+            // key only in this and later records; pad earlier rows
+            Json column(json_array_arg);
+            column.reserve(pivot_rows_ + 1);
+            column.resize(pivot_rows_, Json::null());
+            result.try_emplace(key, std::move(column));
+
+            const std::size_t index = pivot_columns_.size();
+            pivot_index_.emplace(key, index);
+            pivot_keys_.push_back(key);
+            pivot_columns_.resize(index + 1);
+            for (auto& member : result.object_range())
+                pivot_columns_[pivot_index_[member.key()]] = &member.value();
+
+            return index;
+        }
+
+    // append 'value' to the column 'key' of the current row; keys in
+    // 'position' order usually match the previous row's
+    void pivot_row_member(
+        std::size_t position, const std::string& key, Json&& value)
+        {
+            if (typed_) {
+                if (!typed_->set(key, std::move(value)))
+                    stop_duplicate_key(key);
+                return;
+            }
+
+            if (result_.size() == 0) {
+                result_.push_back(Json(json_object_arg));
+            }
+
+            if (position == pivot_hint_.size()) {
+                pivot_hint_.push_back(pivot_ndjson_column(result_[0], key));
+            } else if (pivot_keys_[pivot_hint_[position]] != key) {
+                pivot_hint_[position] = pivot_ndjson_column(result_[0], key);
+            }
+
+            Json* column = pivot_columns_[pivot_hint_[position]];
+            if (column->size() > pivot_rows_)
+                stop_duplicate_key(key);
+            column->push_back(std::move(value));
+        }
+
+    // a key set twice in the current row, usually because unnest_
+    // elements repeat record keys; the parser keeps only the first of
+    // repeated keys in a record, so without unnest_ this is a check
+    void stop_duplicate_key(const std::string& key) const
+        {
+            if (!unnest_.empty())
+                cpp11::stop(
+                    "`j_pivot()` 'unnest' element key '" + key +
+                    "' is also a record key");
+            cpp11::stop(
+                "`j_pivot()` key '" + key + "' is duplicated in record " +
+                std::to_string(pivot_rows_ + 1));
+        }
+
+    // complete the current row; keys not in the row are 'null'
+    void pivot_row_end()
+        {
+            ++pivot_rows_;
+            if (typed_) {
+                typed_->end_row();
+                return;
+            }
+
+            if (result_.size() == 0) {
+                result_.push_back(Json(json_object_arg));
+            }
+
+            for (Json* column : pivot_columns_) {
+                if (column->size() < pivot_rows_)
+                    column->push_back(Json::null());
+            }
         }
-        
+
     void pivot_ndjson(Json j)
         {
             if (j.type() == json_type::null_value) {
@@ -135,113 +298,192 @@ class rquerypivot
                 return;
             }
 
-            if (result_.size() == 0) {
-                // result_.push_back(Json(json_object_arg));
-                for (auto& member: j.object_range()) {
-                    // all members of 'j' need to be JSON arrays
-                    auto key = member.key();
-                    Json ja = Json::make_array(1, j[key]);
-                    j[key].swap(ja);
-                }
-                result_.push_back(j);
-                return;
+            std::size_t position = 0;
+            for (auto& member : j.object_range()) {
+                pivot_row_member(
+                    position++, member.key(), std::move(member.value()));
             }
+            pivot_row_end();
+        }
 
-            // insert j.member after result_[0].member. three cases:
-            // result_[0] & j both have key, key only in result_[0],
-            // key only in j
+    // one row per element of the array 'record[unnest_]', with the
+    // other members of 'record' repeated in each row
+    void pivot_unnest_record(Json& record)
+        {
+            switch(record.type()) {
+            case json_type::null_value:
+                return;
+            case json_type::object_value:
+                break;
+            default: {
+                cpp11::stop("`j_pivot()` 'unnest' records must be objects");
+            }}
 
-            // use unordered_set to keep track of key status in result_[0], j
-            // fill j_keys; trim as each key from j is added to result_[0]
-            std::unordered_set<std::string> j_keys;
-            for (const auto& j_elt : j.object_range()) {
-                j_keys.insert(j_elt.key());
+            auto it = record.find(unnest_);
+            if (it == record.object_range().end())
+                return;
+            Json elements = std::move(it->value());
+            switch(elements.type()) {
+            case json_type::null_value:
+                return;
+            case json_type::array_value:
+                break;
+            case json_type::object_value: {
+                Json ja(json_array_arg);
+                ja.push_back(std::move(elements));
+                elements = std::move(ja);
+                break;
             }
+            default: {
+                cpp11::stop(
+                    "`j_pivot()` 'unnest' member '" + unnest_ +
+                    "' must be an array or object");
+            }}
 
-            // fill r_keys as each element discovered 'missing' from j
-            std::unordered_set<std::string> r_keys;
-            std::size_t n_r = 0; // # of elements in result_[0] before update
-            for (auto& r_elt : result_[0].object_range()) {
-                n_r = std::max(n_r, r_elt.value().size());
-                // j contains result_[0].key...
-                if (j_keys.find(r_elt.key()) == j_keys.end()) {
-                    r_keys.insert(r_elt.key());
-                    continue;
+            const std::size_t n = elements.size();
+            for (std::size_t i = 0; i < n; ++i) {
+                // parent values are copied, except into the last row
+                const bool is_last = i + 1 == n;
+                std::size_t position = 0;
+                for (auto& member : record.object_range()) {
+                    if (member.key() == unnest_)
+                        continue;
+                    pivot_row_member(
+                        position++, member.key(),
+                        is_last ?
+                            std::move(member.value()) : Json(member.value()));
                 }
-                // insert j[r_elt.key()] after r_elt.value()
-                const auto& j_elt = j[r_elt.key()];
-                r_elt.value().push_back(j_elt);
-                // remove key from 'j', leaving keys not in r
-                j_keys.erase(r_elt.key());
+                Json& element = elements[i];
+                if (element.type() == json_type::object_value) {
+                    for (auto& member : element.object_range()) {
+                        pivot_row_member(
+                            position++, member.key(),
+                            std::move(member.value()));
+                    }
+                }
+                pivot_row_end();
             }
+        }
 
-            // key only in result_[0] -- insert 'null'
-            for (auto& r_key : r_keys) {
-                result_[0][r_key].push_back(Json::null());
+    void pivot_unnest(Json j)
+        {
+            if (data_type_ == data_type::json_data_type &&
+                j.type() == json_type::array_value)
+            {
+                for (auto& record : j.array_range())
+                    pivot_unnest_record(record);
+            } else {
+                pivot_unnest_record(j);
+            }
+            if (!typed_ && result_.size() == 0) {
+                // no rows
+                result_.push_back(Json(json_object_arg));
             }
+        }
 
-            // key only in j
-            if (j_keys.size()) {
-                // construct array of n_r 'null' to pad each key
-                Json pad(json_array_arg);
-                pad.reserve(n_r);
-                for (std::size_t i = 0; i < n_r; ++i)
-                    pad.push_back(Json::null());
-                for (auto& j_key : j_keys) {
-                    // initialize key as empty array
-                    result_[0][j_key] = pad;
-                    result_[0][j_key].push_back(j[j_key]);
+    // j_pivot(col_types = ) without 'unnest'; each object is a row,
+    // and other JSON array elements are rows of NA
+    void pivot_typed_record(Json& record)
+        {
+            if (record.type() == json_type::object_value) {
+                std::size_t position = 0;
+                for (auto& member : record.object_range()) {
+                    pivot_row_member(
+                        position++, member.key(), std::move(member.value()));
                 }
             }
+            pivot_row_end();
         }
 
-    // flatten
+    void pivot_typed(Json j)
+        {
+            if (data_type_ == data_type::json_data_type &&
+                j.type() == json_type::array_value)
+            {
+                typed_->reserve(j.size());
+                for (auto& record : j.array_range())
+                    pivot_typed_record(record);
+            } else if (j.type() != json_type::null_value) {
+                pivot_typed_record(j);
+            }
+        }
 
-    Json flatten(Json j)
+    bool prefilter_match(const std::string& line) const
         {
-            switch(path_type_) {
-            case path_type::JSONpointer: return jsonpointer::flatten(j);
-            case path_type::JSONpath: return jsonpath::flatten(j);
-            default: cpp11::stop("`j_flatten()` unsupported 'path_type'");
+            for (const auto& pattern : prefilter_) {
+                if (line.find(pattern) == std::string::npos) {
+                    return false;
+                }
             }
+            return true;
         }
 
-    // transformers for use in do_strings() / do_connection()
-    void identity_transform(Json j)
+    bool keep(const Json& j)
         {
-            result_.push_back(j);
+            return !filter_ || filter_->test(j);
         }
 
+    // transformers for use in do_strings() / do_connection(); records
+    // are moved in and never copied
+    void identity_transform(Json&& j)
+        {
+            result_.push_back(std::move(j));
+        }
 
-    void query_transform(Json j)
+    void query_transform(Json&& j)
         {
-            result_.push_back(query(j));
+            result_.push_back(query(std::move(j)));
         }
 
-    void pivot_transform(Json j)
+    void query_multi_transform(Json&& j)
         {
-            Json q = query(j);
-            if (data_type_ == data_type::json_data_type) {
-                pivot_json(q);
+            for (const auto& path : paths_) {
+                result_.push_back(path->evaluate(j));
+            }
+        }
+
+    void pivot_transform(Json&& j)
+        {
+            Json q = query(std::move(j));
+            if (!unnest_.empty()) {
+                pivot_unnest(std::move(q));
+            } else if (typed_) {
+                pivot_typed(std::move(q));
+            } else if (data_type_ == data_type::json_data_type) {
+                pivot_json(std::move(q));
             } else {
-                pivot_ndjson(q);
+                pivot_ndjson(std::move(q));
             }
         }
 
-    void flatten_transform(Json j)
+    void find_transform(Json&& j)
+        {
+            result_.push_back(find_->find(j));
+        }
+
+    void unflatten_transform(Json&& j)
         {
-            result_.push_back(flatten(j));
+            result_.push_back(unflatten_->unflatten(std::move(j)));
         }
 
     // do_strings() / do_connection()
+    void do_record(Json&& j, void (rquerypivot::*transform)(Json&& j))
+        {
+            if (keep(j)) {
+                (this->*transform)(std::move(j));
+            }
+        }
+
     sexp do_strings(
         const std::vector<std::string>& data,
-        void (rquerypivot::*transform)(Json j))
+        void (rquerypivot::*transform)(Json&& j))
         {
-            result_.reserve(data.size());
+            result_.reserve(
+                data.size() * std::max(paths_.size(), std::size_t(1)));
             for (const auto& datum: data) {
-                Json j = Json::parse(datum);
-                (this->*transform)(j);
+                if (prefilter_match(datum)) {
+                    do_record(Json::parse(datum), transform);
+                }
             }
 
             return as();
@@ -249,28 +491,43 @@ class rquerypivot
 
     sexp do_connection(
         const sexp& con, double n_records,
-        void (rquerypivot::*transform)(Json j))
+        void (rquerypivot::*transform)(Json&& j))
         {
             readbinbuf cbuf(con);
             std::istream is(&cbuf);
 
             switch(data_type_) {
             case data_type::json_data_type: {
-                Json j = Json::parse(is);
-                (this->*transform)(j);
+                do_record(Json::parse(is), transform);
                 break;
             }
             case data_type::ndjson_data_type: {
                 progressbar progress("processing {cli::pb_current} records");
-                json_decoder<Json> decoder;
-                json_stream_reader reader(is, decoder);
                 double n = 0;
 
+                if (!prefilter_.empty()) {
+                    // one record per line; only lines passing the
+                    // prefilter are parsed
+                    std::string line;
+                    while (n < n_records && std::getline(is, line)) {
+                        if (!prefilter_match(line)) {
+                            continue;
+                        }
+                        do_record(Json::parse(line), transform);
+                        n += 1;
+                        if (verbose_) {
+                            progress.tick();
+                        }
+                    }
+                    break;
+                }
+
+                json_decoder<Json> decoder;
+                json_stream_reader reader(is, decoder);
                 while (!reader.eof() && n < n_records) {
                     reader.read_next();
                     if (!reader.eof()) {
-                        Json j = decoder.get_result();
-                        (this->*transform)(j);
+                        do_record(decoder.get_result(), transform);
                         n += 1;
                         if (verbose_) {
                             progress.tick();
@@ -282,6 +539,61 @@ class rquerypivot
             return as();
         }
 
+    // flatten_records(); records are flattened from parser events by
+    // 'visitor', and the transform collects the result
+    void flatten_transform(flatten_visitor<Json>& visitor)
+        {
+            result_.push_back(visitor.get_result());
+        }
+
+    void flatten_columns_transform(flatten_visitor<Json>& visitor)
+        {
+            columns_.append(visitor);
+        }
+
+    void flatten_records(
+        const std::vector<std::string>& data,
+        void (rquerypivot::*transform)(flatten_visitor<Json>&))
+        {
+            flatten_visitor<Json> visitor(path_type_);
+            for (const auto& datum: data) {
+                json_string_reader reader(datum, visitor);
+                reader.read();
+                (this->*transform)(visitor);
+            }
+        }
+
+    void flatten_records(
+        const sexp& con, double n_records,
+        void (rquerypivot::*transform)(flatten_visitor<Json>&))
+        {
+            readbinbuf cbuf(con);
+            std::istream is(&cbuf);
+            flatten_visitor<Json> visitor(path_type_);
+            json_stream_reader reader(is, visitor);
+
+            switch(data_type_) {
+            case data_type::json_data_type: {
+                reader.read();
+                (this->*transform)(visitor);
+                break;
+            }
+            case data_type::ndjson_data_type: {
+                progressbar progress("processing {cli::pb_current} records");
+                double n = 0;
+                while (!reader.eof() && n < n_records) {
+                    reader.read_next();
+                    if (!reader.eof()) {
+                        (this->*transform)(visitor);
+                        n += 1;
+                        if (verbose_) {
+                            progress.tick();
+                        }
+                    }
+                }
+            }}
+        }
+
 public:
     rquerypivot() noexcept = default;
 
@@ -289,9 +601,6 @@ public:
         : as_(as::R),
           data_type_(enum_index(data_type_map, data_type)),
           path_type_(path_type::JSONpointer),
-          jmespath_(jmespath::make_expression<Json>("@")),
-          jsonpath_(jsonpath::make_expression<Json>("$")),
-          jsonpointer_("/"),
           verbose_(verbose)
         {}
 
@@ -301,19 +610,76 @@ public:
         : as_(enum_index(as_map, as)),
           data_type_(enum_index(data_type_map, data_type)),
           path_type_(enum_index(path_type_map, path_type)),
-          // only one 'path' is used; initialize others to a default
-          jmespath_(
-              path_type_ == path_type::JMESpath ?
-              jmespath::make_expression<Json>(path) :
-              jmespath::make_expression<Json>("@")),
-          jsonpath_(
-              path_type_ == path_type::JSONpath ?
-              jsonpath::make_expression<Json>(path) :
-              jsonpath::make_expression<Json>("$")),
-          jsonpointer_(path_type_ == path_type::JSONpointer ? path : "/"),
+          path_(compile_path<Json>(path, path_type_)),
+          verbose_(verbose)
+        {}
+
+    rquerypivot(const std::vector<std::string>& paths,
+           const std::vector<std::string>& path_types,
+           const std::string& as, const std::string& data_type, bool verbose)
+        : as_(enum_index(as_map, as)),
+          data_type_(enum_index(data_type_map, data_type)),
+          path_type_(path_type::JSONpointer),
+          verbose_(verbose)
+        {
+            if (paths.size() != path_types.size())
+                cpp11::stop("'paths' and 'path_types' must have equal length");
+            paths_.reserve(paths.size());
+            for (std::size_t i = 0; i < paths.size(); ++i) {
+                const auto type = enum_index(path_type_map, path_types[i]);
+                paths_.push_back(compile_path<Json>(paths[i], type));
+            }
+        }
+
+    rquerypivot(std::shared_ptr<compiled_path<Json>> path,
+           const std::string& as, const std::string& data_type, bool verbose)
+        : as_(enum_index(as_map, as)),
+          data_type_(enum_index(data_type_map, data_type)),
+          path_type_(path->type()),
+          path_(path),
           verbose_(verbose)
         {}
 
+    // filter; an empty 'path' means no filter
+
+    rquerypivot& filter(const std::string& path, const std::string& path_type)
+        {
+            if (!path.empty()) {
+                const auto type = enum_index(path_type_map, path_type);
+                filter_ = compile_path<Json>(path, type);
+            }
+            return *this;
+        }
+
+    rquerypivot& prefilter(const std::vector<std::string>& patterns)
+        {
+            prefilter_ = patterns;
+            return *this;
+        }
+
+    rquerypivot& threads(int n)
+        {
+            threads_ = std::max(n, 1);
+            return *this;
+        }
+
+    rquerypivot& unnest(const std::string& key)
+        {
+            unnest_ = key;
+            return *this;
+        }
+
+    // declare column names and R types ("logical", "integer",
+    // "numeric", "character", "list"); no names means no declared types
+    rquerypivot& col_types(
+        const std::vector<std::string>& names,
+        const std::vector<std::string>& types)
+        {
+            if (!names.empty())
+                typed_.reset(new typed_columns<Json>(names, types));
+            return *this;
+        }
+
     // as_r
 
     sexp as_r(const std::vector<std::string>& data)
@@ -340,10 +706,26 @@ public:
             return do_connection(con, n_records, &rquerypivot::query_transform);
         }
 
+    // query_multi; one list element per path
+
+    sexp query_multi(const std::vector<std::string>& data)
+        {
+            return do_strings(data, &rquerypivot::query_multi_transform);
+        }
+
+    sexp query_multi(const sexp& con, double n_records)
+        {
+            return do_connection(
+                con, n_records, &rquerypivot::query_multi_transform
+            );
+        }
+
     // pivot
 
     sexp pivot(const std::vector<std::string>& data)
         {
+            if (typed_ && data_type_ == data_type::ndjson_data_type)
+                typed_->reserve(data.size());
             // collect queries across all data
             return do_strings(data, &rquerypivot::pivot_transform);
         }
@@ -353,32 +735,158 @@ public:
             return do_connection(con, n_records, &rquerypivot::pivot_transform);
         }
 
-    // flatten
+    // flatten; records are flattened from parser events, without
+    // constructing the record
 
     sexp flatten(const std::vector<std::string>& data)
         {
-            return do_strings(data, &rquerypivot::flatten_transform);
+            result_.reserve(data.size());
+            flatten_records(data, &rquerypivot::flatten_transform);
+            return as();
         }
 
     sexp flatten(const sexp& con, double n_records)
         {
-            return
-                do_connection(con, n_records, &rquerypivot::flatten_transform);
+            flatten_records(con, n_records, &rquerypivot::flatten_transform);
+            return as();
+        }
+
+    // flatten to columns 'record_id' (NDJSON only), 'path', and 'value'
+
+    sexp flatten_columns(const std::vector<std::string>& data)
+        {
+            flatten_records(data, &rquerypivot::flatten_columns_transform);
+            return columns_.as_r(data_type_ == data_type::ndjson_data_type);
+        }
+
+    sexp flatten_columns(const sexp& con, double n_records)
+        {
+            flatten_records(
+                con, n_records, &rquerypivot::flatten_columns_transform);
+            return columns_.as_r(data_type_ == data_type::ndjson_data_type);
+        }
+
+    // unflatten; each JSON document or NDJSON record is a flat object,
+    // or 'path' and 'value' columns, with consecutive rows of the same
+    // 'record_id' forming a record
+
+    sexp unflatten(const std::vector<std::string>& data)
+        {
+            unflatten_.reset(new unflattener<Json>(path_type_));
+            return do_strings(data, &rquerypivot::unflatten_transform);
+        }
+
+    sexp unflatten(const sexp& con, double n_records)
+        {
+            unflatten_.reset(new unflattener<Json>(path_type_));
+            return do_connection(
+                con, n_records, &rquerypivot::unflatten_transform);
+        }
+
+    sexp unflatten(
+        const std::vector<int>& record_id,
+        const std::vector<std::string>& path, const sexp& value)
+        {
+            std::vector<Json> values = r_column_as_json<Json>(value);
+            if (path.size() != values.size() ||
+                (!record_id.empty() && record_id.size() != path.size()))
+                cpp11::stop(
+                    "'record_id', 'path', and 'value' must have equal length");
+
+            unflattener<Json> unflatten(path_type_);
+            for (std::size_t i = 0; i < path.size(); ++i) {
+                const bool is_new_record =
+                    i > 0 && !record_id.empty() &&
+                    record_id[i] != record_id[i - 1];
+                if (is_new_record)
+                    result_.push_back(unflatten.get_result());
+                unflatten.push_back(path[i], std::move(values[i]));
+            }
+            result_.push_back(unflatten.get_result());
+
+            return as();
+        }
+
+    // find; 'target' is interpreted according to 'find_type'
+
+    sexp find(
+        const std::vector<std::string>& data,
+        const std::string& find_type, const sexp& target)
+        {
+            find_.reset(new j_find<Json>(
+                enum_index(find_type_map, find_type), path_type_, target));
+            return do_strings(data, &rquerypivot::find_transform);
+        }
+
+    sexp find(
+        const sexp& con, double n_records,
+        const std::string& find_type, const sexp& target)
+        {
+            find_.reset(new j_find<Json>(
+                enum_index(find_type_map, find_type), path_type_, target));
+            return do_connection(con, n_records, &rquerypivot::find_transform);
         }
 
     // as
 
     sexp as() const
+        {
+            if (typed_)
+                return typed_->as_r();
+
+            if (!unnest_.empty())
+                return as_ == as::R ?
+                    as_columns() : j_as(unnest_columns(), as_);
+
+            if (paths_.empty())
+                return as(0, 1);
+
+            // split interleaved results into one element per path
+            const std::size_t n_paths = paths_.size();
+            writable::list result(n_paths);
+            for (std::size_t i = 0; i < n_paths; ++i)
+                result[i] = as(i, n_paths);
+
+            return result;
+        }
+
+    // the object-of-arrays of unnest_ rows; empty when no record
+    // reaches pivot_unnest(), e.g., none satisfy 'filter'
+    const Json& unnest_columns() const
+        {
+            static const Json empty(json_object_arg);
+            return result_.empty() ? empty : result_[0];
+        }
+
+    // coerce unnest_columns() to a named list of typed R vectors,
+    // with 'null' as NA
+    sexp as_columns() const
+        {
+            const Json& columns = unnest_columns();
+            writable::list result(columns.size());
+            writable::strings names(columns.size());
+            R_xlen_t i = 0;
+            for (const auto& member : columns.object_range()) {
+                names[i] = member.key();
+                result[i++] = j_as_r_column(member.value());
+            }
+            result.names() = names;
+
+            return result;
+        }
+
+    // coerce result_[start], result_[start + stride], ...
+    sexp as(std::size_t start, std::size_t stride) const
         {
             progressbar progress("coercing {cli::pb_current} records");
-            const writable::list result(result_.size());
-            auto fun = [&](Json j) {
+            const std::size_t n = result_.size() / stride;
+            writable::list result(n);
+            for (std::size_t i = 0; i < n; ++i) {
                 if (verbose_) {
                     progress.tick();
                 }
-                return j_as(j, as_);
-            };
-            std::transform(result_.begin(), result_.end(), result.begin(), fun);
+                result[i] = j_as(result_[start + i * stride], as_);
+            }
 
             return as_ == as::string ?
                 package("base")["unlist"](result) : result;
@@ -1,10 +1,19 @@
 #include <jsoncons/json.hpp>
 #include <jsoncons_ext/jsonschema/jsonschema.hpp>
 
+#include <iterator>
+
 #include "readbinbuf.h"
+#include "lru_cache.h"
 #include "j_as.h"
+#include "schema_validator.h"
+#include "schema_errors.h"
+#include "schema_stream.h"
+#include "schema_registry.h"
+#include "schema_columns.h"
 
 #include <cpp11/as.hpp>
+#include <cpp11/external_pointer.hpp>
 #include <cpp11/sexp.hpp>
 #include <cpp11/protect.hpp> // 'stop'
 
@@ -24,31 +33,247 @@ Json sexp_to_json(const sexp& data)
     }
 }
 
+// a compiled schema, its streaming form when the schema allows, and
+// the columns of the records it describes; the payload of the
+// external pointer returned by j_schema_compile()
+
+struct schema_entry {
+    compiled_schema_ptr compiled;
+    std::shared_ptr<const schema_stream> stream;
+    schema_columns columns;
+};
+
+using schema_entry_ptr = std::shared_ptr<const schema_entry>;
+
+// schemas are compiled once and cached across calls, keyed by the
+// schema text and registry, so repeated validation against the same
+// schema only parses and evaluates 'data'
+
+schema_entry_ptr compile_schema(
+    const std::string& schema, const schema_registry_ptr& registry)
+{
+    static lru_cache<std::string, const schema_entry> cache(32);
+    std::string key = schema;
+    if (registry)
+        key.append(1, '\0').append(std::to_string(registry->id()));
+    return cache.get(key, [&]() {
+        const auto schema_ = ojson::parse(schema);
+        auto entry = std::make_shared<schema_entry>();
+        if (registry) {
+            entry->compiled = std::make_shared<const compiled_schema>(
+                jsonschema::make_json_schema(
+                    schema_, [&](const jsoncons::uri& uri) {
+                        return registry->resolve(uri);
+                    }));
+        } else {
+            entry->compiled = std::make_shared<const compiled_schema>(
+                jsonschema::make_json_schema(schema_));
+        }
+        entry->stream = schema_stream::make(schema_);
+        entry->columns = schema_columns::make(schema_);
+        return entry;
+    });
+}
+
+// 'registry' is NULL or the external pointer from j_schema_registry()
+schema_registry_ptr sexp_to_registry(const sexp& registry)
+{
+    if (Rf_isNull(registry))
+        return nullptr;
+    external_pointer<schema_registry_ptr> ptr(registry);
+    if (ptr.get() == nullptr)
+        cpp11::stop(
+            "schema registry is no longer valid; use `j_schema_registry()`"
+        );
+    return *ptr;
+}
+
+// 'schema' is a JSON string, a connection, or the external pointer
+// from j_schema_compile(); 'registry' is used only when compiling
+schema_entry_ptr sexp_to_schema(
+    const sexp& schema, const sexp& registry = R_NilValue)
+{
+    if (TYPEOF(schema) == EXTPTRSXP) {
+        external_pointer<schema_entry_ptr> ptr(schema);
+        if (ptr.get() == nullptr) {
+            // e.g., after saveRDS() / readRDS()
+            cpp11::stop(
+                "compiled schema is no longer valid; use `j_schema_compile()`"
+            );
+        }
+        return *ptr;
+    }
+
+    if (Rf_isString(schema))
+        return compile_schema(
+            as_cpp<const std::string&>(schema), sexp_to_registry(registry));
+
+    // file or URL; read the text to use as the cache key
+    readbinbuf cbuf(schema);
+    std::istream is(&cbuf);
+    const std::string text(
+        (std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    return compile_schema(text, sexp_to_registry(registry));
+}
+
+[[cpp11::register]]
+sexp cpp_j_schema_registry(const std::vector<std::string>& schemas)
+{
+    return external_pointer<schema_registry_ptr>(
+        new schema_registry_ptr(std::make_shared<schema_registry>(schemas)));
+}
+
+[[cpp11::register]]
+std::vector<std::string> cpp_j_schema_registry_uris(const sexp& registry)
+{
+    return sexp_to_registry(registry)->uris();
+}
+
+[[cpp11::register]]
+sexp cpp_j_schema_compile(const sexp& schema, const sexp& registry)
+{
+    return external_pointer<schema_entry_ptr>(
+        new schema_entry_ptr(sexp_to_schema(schema, registry)));
+}
+
 [[cpp11::register]]
 bool cpp_j_schema_is_valid(
     const sexp& data,
-    const sexp& schema)
+    const sexp& schema,
+    const sexp& registry)
 {
-    const auto data_ = sexp_to_json<ojson>(data);
-    const auto schema_ = sexp_to_json<ojson>(schema);
-    const auto compiled = jsonschema::make_json_schema(schema_);
+    const auto schema_ = sexp_to_schema(schema, registry);
+
+    // validate as 'data' is parsed, without constructing it
+    if (schema_->stream) {
+        if (Rf_isString(data))
+            return schema_->stream->is_valid(as_cpp<const std::string&>(data));
+        readbinbuf cbuf(data);
+        std::istream is(&cbuf);
+        return schema_->stream->is_valid(is);
+    }
 
-    return compiled.is_valid(data_);
+    const auto data_ = sexp_to_json<ojson>(data);
+    return schema_->compiled->is_valid(data_);
 }
 
 [[cpp11::register]]
 sexp cpp_j_schema_validate(
     const sexp& data,
     const sexp& schema,
-    const std::string& as)
+    const std::string& as,
+    const sexp& registry)
 {
     const auto data_ = sexp_to_json<ojson>(data);
-    const auto schema_ = sexp_to_json<ojson>(schema);
-    const auto compiled = jsonschema::make_json_schema(schema_);
+    const auto compiled = sexp_to_schema(schema, registry)->compiled;
+
+    // "columns" or "details": written directly to columns
+    if (as == "columns" || as == "details") {
+        schema_errors errors(as == "details");
+        compiled->validate(data_, [&](
+            const jsonschema::validation_message& message)
+        {
+            errors.add(message, 1);
+        });
+        return errors.as_r(false);
+    }
 
     json_decoder<ojson> decoder;
-    compiled.validate(data_, decoder);
+    compiled->validate(data_, decoder);
     const ojson output = decoder.get_result();
 
     return j_as(output, as);
 }
+
+// NDJSON; 'schema' is the external pointer from j_schema_compile()
+
+void check_ndjson(const std::string& data_type)
+{
+    if (data_type != "ndjson")
+        cpp11::stop(
+            "`data_type` must be 'ndjson', not '%s'", data_type.c_str()
+        );
+}
+
+[[cpp11::register]]
+sexp cpp_j_schema_is_valid_ndjson(
+    const std::vector<std::string>& data, const std::string& data_type,
+    const sexp& schema, const bool stop_on_invalid, const int threads)
+{
+    check_ndjson(data_type);
+    const auto schema_ = sexp_to_schema(schema);
+    return
+        schema_validator(schema_->compiled, stop_on_invalid, false).
+        threads(threads).stream(schema_->stream).is_valid(data);
+}
+
+[[cpp11::register]]
+sexp cpp_j_schema_is_valid_ndjson_con(
+    const sexp& con, const std::string& data_type,
+    const sexp& schema, const bool stop_on_invalid, const int threads,
+    const double n_records, const bool verbose)
+{
+    check_ndjson(data_type);
+    const auto schema_ = sexp_to_schema(schema);
+    return
+        schema_validator(schema_->compiled, stop_on_invalid, verbose).
+        threads(threads).stream(schema_->stream).is_valid(con, n_records);
+}
+
+[[cpp11::register]]
+sexp cpp_j_schema_validate_ndjson(
+    const std::vector<std::string>& data, const std::string& data_type,
+    const sexp& schema, const std::string& as, const bool stop_on_invalid,
+    const int threads)
+{
+    check_ndjson(data_type);
+    return
+        schema_validator(sexp_to_schema(schema)->compiled, stop_on_invalid, false).
+        threads(threads).validate(data, as);
+}
+
+[[cpp11::register]]
+sexp cpp_j_schema_validate_ndjson_con(
+    const sexp& con, const std::string& data_type,
+    const sexp& schema, const std::string& as, const bool stop_on_invalid,
+    const int threads, const double n_records, const bool verbose)
+{
+    check_ndjson(data_type);
+    return
+        schema_validator(sexp_to_schema(schema)->compiled, stop_on_invalid, verbose).
+        threads(threads).validate(con, n_records, as);
+}
+
+// NDJSON to typed columns declared by the schema's 'properties'
+
+const schema_columns& pivot_columns(const schema_entry_ptr& schema)
+{
+    if (schema->columns.names.empty())
+        cpp11::stop("`schema` has no 'properties' to define columns");
+    return schema->columns;
+}
+
+[[cpp11::register]]
+sexp cpp_j_schema_pivot(
+    const std::vector<std::string>& data, const std::string& data_type,
+    const sexp& schema, const int threads)
+{
+    check_ndjson(data_type);
+    const auto schema_ = sexp_to_schema(schema);
+    return
+        schema_validator(schema_->compiled, true, false).
+        threads(threads).pivot(data, pivot_columns(schema_));
+}
+
+[[cpp11::register]]
+sexp cpp_j_schema_pivot_con(
+    const sexp& con, const std::string& data_type,
+    const sexp& schema, const int threads,
+    const double n_records, const bool verbose)
+{
+    check_ndjson(data_type);
+    const auto schema_ = sexp_to_schema(schema);
+    return
+        schema_validator(schema_->compiled, true, verbose).
+        threads(threads).pivot(con, n_records, pivot_columns(schema_));
+}
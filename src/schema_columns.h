@@ -0,0 +1,144 @@
+#ifndef RJSONCONS_SCHEMA_COLUMNS_H
+#define RJSONCONS_SCHEMA_COLUMNS_H
+
+#include <climits>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+
+using namespace jsoncons;
+
+// The columns of a data.frame of records described by a JSON schema,
+// for j_schema_pivot(): one column per member of the schema's
+// 'properties', in order. The R type of each column follows the
+// member's 'type' or, without 'type', the values of its 'enum' or
+// 'const'. "null" makes a column nullable (NA) but does not change
+// its type; "integer" is integer only when the schema bounds values
+// to the range of R integers, otherwise numeric; "integer" and
+// "number" together are numeric; other combinations, "array",
+// "object", and unconstrained members are list columns.
+
+struct schema_columns
+{
+    std::vector<std::string> names, types;
+
+private:
+    // JSON schema type names of a value in 'enum' or 'const'
+    static std::string json_type_name(const ojson& value)
+        {
+            switch(value.type()) {
+            case json_type::null_value:
+                return "null";
+            case json_type::bool_value:
+                return "boolean";
+            case json_type::int64_value:
+            case json_type::uint64_value:
+                return "integer";
+            case json_type::double_value:
+                return "number";
+            case json_type::string_value:
+                return "string";
+            case json_type::array_value:
+                return "array";
+            default:
+                return "object";
+            }
+        }
+
+    // R integers are 32-bit, with INT_MIN as NA
+    static bool is_r_integer(const ojson& value)
+        {
+            if (!value.is_number())
+                return false;
+            const double x = value.as_double();
+            return x > INT_MIN && x <= INT_MAX;
+        }
+
+    // a numeric bound from 'inclusive' (e.g., "minimum") or
+    // 'exclusive' (e.g., "exclusiveMinimum"; boolean in draft 4)
+    static bool has_r_integer_bound(
+        const ojson& property, const char* inclusive, const char* exclusive)
+        {
+            return
+                (property.contains(inclusive) &&
+                 is_r_integer(property.at(inclusive))) ||
+                (property.contains(exclusive) &&
+                 is_r_integer(property.at(exclusive)));
+        }
+
+    // every valid "integer" value of 'property' is an R integer, so
+    // the column need not be numeric
+    static bool in_r_integer_range(const ojson& property)
+        {
+            if (property.contains("const"))
+                return is_r_integer(property.at("const"));
+            if (property.contains("enum") && property.at("enum").is_array()) {
+                for (const auto& value : property.at("enum").array_range()) {
+                    if (!value.is_null() && !is_r_integer(value))
+                        return false;
+                }
+                return true;
+            }
+            return
+                has_r_integer_bound(property, "minimum", "exclusiveMinimum") &&
+                has_r_integer_bound(property, "maximum", "exclusiveMaximum");
+        }
+
+    static std::string col_type(const ojson& property)
+        {
+            std::set<std::string> json_types;
+            if (property.is_object() && property.contains("type")) {
+                const ojson& type = property.at("type");
+                if (type.is_string()) {
+                    json_types.insert(type.as_string());
+                } else if (type.is_array()) {
+                    for (const auto& elt : type.array_range()) {
+                        if (elt.is_string())
+                            json_types.insert(elt.as_string());
+                    }
+                }
+            } else if (property.is_object() && property.contains("const")) {
+                json_types.insert(json_type_name(property.at("const")));
+            } else if (property.is_object() && property.contains("enum") &&
+                       property.at("enum").is_array()) {
+                for (const auto& value : property.at("enum").array_range())
+                    json_types.insert(json_type_name(value));
+            }
+            json_types.erase("null");
+
+            if (json_types.size() == 2 &&
+                json_types.count("integer") && json_types.count("number"))
+                return "numeric";
+            if (json_types.size() != 1)
+                return "list";
+            const std::string& json_type = *json_types.begin();
+            if (json_type == "boolean")
+                return "logical";
+            if (json_type == "integer")
+                return in_r_integer_range(property) ? "integer" : "numeric";
+            if (json_type == "number")
+                return "numeric";
+            if (json_type == "string")
+                return "character";
+            return "list";
+        }
+
+public:
+    // empty when 'schema' has no 'properties'
+    static schema_columns make(const ojson& schema)
+        {
+            schema_columns columns;
+            if (!schema.is_object() || !schema.contains("properties") ||
+                !schema.at("properties").is_object())
+                return columns;
+            for (const auto& member : schema.at("properties").object_range()) {
+                columns.names.push_back(member.key());
+                columns.types.push_back(col_type(member.value()));
+            }
+            return columns;
+        }
+};
+
+#endif
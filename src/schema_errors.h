@@ -0,0 +1,129 @@
+#ifndef RJSONCONS_SCHEMA_ERRORS_H
+#define RJSONCONS_SCHEMA_ERRORS_H
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/jsonschema/jsonschema.hpp>
+
+#include "j_as.h"
+
+#include <cpp11/list.hpp>
+#include <cpp11/logicals.hpp>
+#include <cpp11/integers.hpp>
+#include <cpp11/strings.hpp>
+
+using namespace jsoncons;
+using namespace rjsoncons;
+
+// Validation errors written directly to the columns of a data.frame,
+// one row per error or, with 'details', one row per detail of each
+// error. Columns follow the members of j_schema_validate() JSON
+// output, with the 'keyword' of each error; the 'details' column
+// holds the (nested) details of each row, as from as = "R".
+
+class schema_errors
+{
+    const bool details_;
+    std::vector<int> record_id_;
+    std::vector<std::string>
+        evaluation_path_, schema_location_, instance_location_,
+        keyword_, error_;
+    std::vector<std::vector<jsonschema::validation_message>> nested_;
+
+    void push_back(
+        const jsonschema::validation_message& message, int record_id)
+        {
+            record_id_.push_back(record_id);
+            evaluation_path_.push_back(message.eval_path().string());
+            schema_location_.push_back(message.schema_location().string());
+            instance_location_.push_back(message.instance_location().string());
+            keyword_.push_back(message.keyword());
+            error_.push_back(message.message());
+            nested_.push_back(message.details());
+        }
+
+    static sexp as_strings(const std::vector<std::string>& values)
+        {
+            writable::strings column(values.size());
+            for (std::size_t i = 0; i < values.size(); ++i)
+                column[i] = values[i];
+            return column;
+        }
+
+    // details as j_schema_validate(as = "R"); NULL when there are none
+    static sexp as_details(
+        const std::vector<jsonschema::validation_message>& details)
+        {
+            if (details.empty())
+                return R_NilValue;
+            json_decoder<ojson> decoder;
+            decoder.begin_array();
+            jsonschema::validation_message_to_json_adaptor adaptor(decoder);
+            for (const auto& detail : details)
+                adaptor(detail);
+            decoder.end_array();
+            return j_as_r(decoder.get_result());
+        }
+
+public:
+    schema_errors(bool details)
+        : details_(details)
+        {}
+
+    // 'record_id' is the 1-based index of the NDJSON record
+    void add(const jsonschema::validation_message& message, int record_id)
+        {
+            if (!details_) {
+                push_back(message, record_id);
+                return;
+            }
+            for (const auto& detail : message.details())
+                push_back(detail, record_id);
+        }
+
+    sexp as_r(bool with_record_id) const
+        {
+            writable::list result(with_record_id ? 8 : 7);
+            writable::strings names(result.size());
+            R_xlen_t i = 0;
+
+            if (with_record_id) {
+                writable::integers record_id(record_id_.size());
+                std::copy(
+                    record_id_.cbegin(), record_id_.cend(), record_id.begin());
+                names[i] = "record_id";
+                result[i++] = record_id;
+            }
+
+            writable::logicals valid(error_.size());
+            for (std::size_t j = 0; j < error_.size(); ++j)
+                valid[j] = false;
+            names[i] = "valid";
+            result[i++] = valid;
+
+            names[i] = "evaluationPath";
+            result[i++] = as_strings(evaluation_path_);
+            names[i] = "schemaLocation";
+            result[i++] = as_strings(schema_location_);
+            names[i] = "instanceLocation";
+            result[i++] = as_strings(instance_location_);
+            names[i] = "keyword";
+            result[i++] = as_strings(keyword_);
+            names[i] = "error";
+            result[i++] = as_strings(error_);
+
+            writable::list details(nested_.size());
+            for (std::size_t j = 0; j < nested_.size(); ++j)
+                details[j] = as_details(nested_[j]);
+            names[i] = "details";
+            result[i] = details;
+
+            result.names() = names;
+            return result;
+        }
+};
+
+#endif
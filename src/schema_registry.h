@@ -0,0 +1,91 @@
+#ifndef RJSONCONS_SCHEMA_REGISTRY_H
+#define RJSONCONS_SCHEMA_REGISTRY_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/uri.hpp>
+
+#include <cpp11/protect.hpp> // 'stop'
+
+using namespace jsoncons;
+
+// Schemas preloaded by j_schema_registry(), parsed once and keyed by
+// the URI in their '$id' (without fragment). A schema compiled with
+// the registry resolves '$ref's to other documents from the registry
+// only; references to documents not in the registry are errors, and
+// nothing is read from files or the network.
+
+class schema_registry
+{
+    std::map<std::string, ojson> schemas_;
+    // distinguishes registries in the cache of compiled schemas
+    const std::size_t id_;
+
+    static std::size_t next_id()
+        {
+            static std::size_t id = 0;
+            return ++id;
+        }
+
+    // '$id', or 'id' in draft 4 schemas
+    static std::string schema_id(const ojson& schema)
+        {
+            if (schema.contains("$id") && schema.at("$id").is_string())
+                return schema.at("$id").as_string();
+            if (schema.contains("$schema") && schema.contains("id") &&
+                schema.at("$schema") == "http://json-schema.org/draft-04/schema#" &&
+                schema.at("id").is_string())
+                return schema.at("id").as_string();
+            return std::string();
+        }
+
+public:
+    schema_registry(const std::vector<std::string>& schemas)
+        : id_(next_id())
+        {
+            for (std::size_t i = 0; i < schemas.size(); ++i) {
+                ojson schema = ojson::parse(schemas[i]);
+                const std::string id = schema.is_object() ?
+                    schema_id(schema) : std::string();
+                if (id.empty())
+                    cpp11::stop(
+                        "schema %d is not an object with an '$id'",
+                        static_cast<int>(i + 1)
+                    );
+                const std::string key = jsoncons::uri(id).base().string();
+                if (!schemas_.emplace(key, std::move(schema)).second)
+                    cpp11::stop("more than one schema has '$id' '%s'",
+                                key.c_str());
+            }
+        }
+
+    std::size_t id() const
+        {
+            return id_;
+        }
+
+    std::vector<std::string> uris() const
+        {
+            std::vector<std::string> uris;
+            for (const auto& schema : schemas_)
+                uris.push_back(schema.first);
+            return uris;
+        }
+
+    // the schema resolver, called with the base URI of each document
+    // referenced while compiling; null when the registry has no
+    // schema with that URI
+    ojson resolve(const jsoncons::uri& uri) const
+        {
+            auto it = schemas_.find(uri.base().string());
+            return it == schemas_.end() ? ojson::null() : it->second;
+        }
+};
+
+using schema_registry_ptr = std::shared_ptr<const schema_registry>;
+
+#endif
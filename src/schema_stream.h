@@ -0,0 +1,641 @@
+#ifndef RJSONCONS_SCHEMA_STREAM_H
+#define RJSONCONS_SCHEMA_STREAM_H
+
+#include <istream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/jsonschema/jsonschema.hpp>
+#include <rjsoncons/schema_regex.hpp>
+
+#include "record_parser.h"
+
+using namespace jsoncons;
+
+// Validate a single JSON document against a schema from parser
+// events, without constructing the document. Keywords describing the
+// structure of the document -- 'type', 'required', 'properties',
+// 'patternProperties', 'additionalProperties', 'items', 'prefixItems',
+// and the min / max number of items and properties -- are evaluated
+// as the document is parsed. Any other subschema, e.g., with 'enum',
+// 'uniqueItems', 'contains', or 'anyOf', is compiled on its own and
+// applied to each value it describes, constructing only that value.
+//
+// Schemas with references ('$ref', '$id', ...) or draft 4 schemas
+// are not streamed; make() returns nullptr and the document should
+// be validated after parsing.
+
+class schema_stream
+{
+    using compiled_type = jsonschema::json_schema<ojson>;
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    enum types : unsigned {
+        null_bit = 1, boolean_bit = 2, integer_bit = 4, number_bit = 8,
+        string_bit = 16, array_bit = 32, object_bit = 64
+    };
+
+    struct node {
+        enum { always_true, always_false, streamed, compiled } kind;
+        // 'compiled' nodes
+        std::shared_ptr<const compiled_type> schema;
+        // 'streamed' nodes; no types means any type
+        unsigned types = 0;
+        std::vector<std::string> required;
+        std::map<std::string, std::size_t> properties;
+        std::vector<std::pair<rjsoncons::schema_regex, std::size_t>>
+            pattern_properties;
+        std::size_t additional_properties = npos;
+        std::size_t min_properties = 0, max_properties = npos;
+        std::vector<std::size_t> prefix_items;
+        std::size_t items = npos;
+        std::size_t min_items = 0, max_items = npos;
+    };
+
+    std::vector<node> nodes_;
+    std::size_t root_ = npos;
+    ojson dialect_;             // '$schema' of the root, or null
+    bool draft202012_;
+
+    // keywords that do not affect validation
+    static bool is_annotation(const std::string& keyword)
+        {
+            static const std::vector<std::string> keywords = {
+                "$schema", "$comment", "$defs", "definitions", "title",
+                "description", "default", "examples", "readOnly",
+                "writeOnly", "deprecated"
+            };
+            for (const auto& k : keywords)
+                if (k == keyword)
+                    return true;
+            return false;
+        }
+
+    // keywords that refer to or identify other schemas
+    static bool has_references(const ojson& j)
+        {
+            static const std::vector<std::string> keywords = {
+                "$ref", "$id", "$anchor", "$dynamicRef", "$dynamicAnchor",
+                "$recursiveRef", "$recursiveAnchor"
+            };
+            if (j.is_array()) {
+                for (const auto& value : j.array_range())
+                    if (has_references(value))
+                        return true;
+            } else if (j.is_object()) {
+                for (const auto& member : j.object_range()) {
+                    for (const auto& k : keywords)
+                        if (member.key() == k)
+                            return true;
+                    if (has_references(member.value()))
+                        return true;
+                }
+            }
+            return false;
+        }
+
+    static bool as_size(const ojson& j, std::size_t& size)
+        {
+            if (j.is_uint64() || (j.is_int64() && j.as<int64_t>() >= 0)) {
+                size = j.as<std::size_t>();
+                return true;
+            }
+            return false;
+        }
+
+    // as for jsoncons' type_validator; unknown type names are ignored
+    static bool as_types(const ojson& j, unsigned& types)
+        {
+            static const std::vector<std::pair<std::string, unsigned>> names = {
+                {"null", null_bit}, {"boolean", boolean_bit},
+                {"integer", integer_bit}, {"number", number_bit},
+                {"string", string_bit}, {"array", array_bit},
+                {"object", object_bit}
+            };
+            std::vector<ojson> values;
+            if (j.is_string()) {
+                values.push_back(j);
+            } else if (j.is_array()) {
+                values.assign(j.array_range().begin(), j.array_range().end());
+            } else {
+                return false;
+            }
+            for (const auto& value : values) {
+                if (!value.is_string())
+                    return false;
+                for (const auto& name : names)
+                    if (value.as_string_view() == name.first)
+                        types |= name.second;
+            }
+            return true;
+        }
+
+    std::size_t add_compiled(const ojson& schema)
+        {
+            ojson schema_ = schema;
+            if (!dialect_.is_null() && !schema_.contains("$schema"))
+                schema_.try_emplace("$schema", dialect_);
+            node n;
+            n.kind = node::compiled;
+            n.schema = std::make_shared<const compiled_type>(
+                jsonschema::make_json_schema(std::move(schema_)));
+            nodes_.push_back(std::move(n));
+            return nodes_.size() - 1;
+        }
+
+    // the node for 'schema', and any of its subschemas
+    std::size_t add_node(const ojson& schema)
+        {
+            node n;
+            if (schema.is_bool()) {
+                n.kind = schema.as<bool>() ? node::always_true : node::always_false;
+                nodes_.push_back(std::move(n));
+                return nodes_.size() - 1;
+            }
+
+            if (!schema.is_object())
+                return add_compiled(schema);
+
+            // check that all keywords can be streamed before adding
+            // subschemas
+            n.kind = node::streamed;
+            for (const auto& member : schema.object_range()) {
+                const std::string& key = member.key();
+                const ojson& value = member.value();
+                bool ok = true;
+                if (is_annotation(key)) {
+                    continue;
+                } else if (key == "type") {
+                    ok = as_types(value, n.types);
+                } else if (key == "required") {
+                    ok = value.is_array();
+                    if (ok) {
+                        for (const auto& name : value.array_range())
+                            ok = ok && name.is_string();
+                    }
+                } else if (key == "properties" || key == "patternProperties") {
+                    ok = value.is_object();
+                } else if (key == "additionalProperties") {
+                    ok = value.is_object() || value.is_bool();
+                } else if (key == "items") {
+                    ok = draft202012_ && (value.is_object() || value.is_bool());
+                } else if (key == "prefixItems") {
+                    ok = draft202012_ && value.is_array();
+                } else if (key == "minProperties") {
+                    ok = as_size(value, n.min_properties);
+                } else if (key == "maxProperties") {
+                    ok = as_size(value, n.max_properties);
+                } else if (key == "minItems") {
+                    ok = as_size(value, n.min_items);
+                } else if (key == "maxItems") {
+                    ok = as_size(value, n.max_items);
+                } else {
+                    ok = false;
+                }
+                if (!ok)
+                    return add_compiled(schema);
+            }
+
+            auto it = schema.find("required");
+            if (it != schema.object_range().end())
+                n.required = it->value().as<std::vector<std::string>>();
+            it = schema.find("properties");
+            if (it != schema.object_range().end()) {
+                for (const auto& member : it->value().object_range())
+                    n.properties[member.key()] = add_node(member.value());
+            }
+            it = schema.find("patternProperties");
+            if (it != schema.object_range().end()) {
+                for (const auto& member : it->value().object_range())
+                    n.pattern_properties.emplace_back(
+                        rjsoncons::schema_regex(member.key()),
+                        add_node(member.value()));
+            }
+            it = schema.find("additionalProperties");
+            if (it != schema.object_range().end())
+                n.additional_properties = add_node(it->value());
+            it = schema.find("prefixItems");
+            if (it != schema.object_range().end()) {
+                for (const auto& item : it->value().array_range())
+                    n.prefix_items.push_back(add_node(item));
+            }
+            it = schema.find("items");
+            if (it != schema.object_range().end())
+                n.items = add_node(it->value());
+
+            nodes_.push_back(std::move(n));
+            return nodes_.size() - 1;
+        }
+
+    // as for jsoncons' type_validator
+    static bool has_type(unsigned types, const ojson& value)
+        {
+            if (types == 0)
+                return true;
+            if (((types & null_bit) && value.is_null()) ||
+                ((types & boolean_bit) && value.is_bool()) ||
+                ((types & string_bit) && value.is_string()) ||
+                ((types & array_bit) && value.is_array()) ||
+                ((types & object_bit) && value.is_object()) ||
+                ((types & number_bit) && value.is_number()))
+                return true;
+            return (types & integer_bit) && value.is_number() &&
+                (value.is_integer<int64_t>() ||
+                 (value.is_double() &&
+                  static_cast<double>(value.as<int64_t>()) == value.as<double>()));
+        }
+
+    // parser events; evaluation stops, but parsing continues, after the
+    // first error
+    class evaluator : public basic_json_visitor<char>
+    {
+        struct active {
+            std::size_t node;
+            std::size_t count;          // items or properties seen
+            std::vector<char> seen;     // required properties seen
+        };
+
+        struct frame {
+            bool is_array;
+            std::vector<active> nodes;
+            std::vector<std::size_t> member_nodes;  // for the current key
+        };
+
+        // a value constructed for 'compiled' nodes
+        struct capture {
+            std::size_t depth;
+            std::vector<std::size_t> nodes;
+            json_decoder<ojson> decoder;
+
+            capture(std::size_t depth, std::vector<std::size_t>&& nodes)
+                : depth(depth), nodes(std::move(nodes))
+                {}
+        };
+
+        const schema_stream& schema_;
+        std::vector<frame> stack_;
+        std::vector<std::unique_ptr<capture>> captures_;
+        std::vector<std::size_t> value_nodes_;
+        bool valid_ = true;
+        bool empty_ = true;         // no value, e.g., empty input
+
+        const node& at(std::size_t i) const
+            {
+                return schema_.nodes_[i];
+            }
+
+        // the nodes describing the value that is starting
+        void begin_value()
+            {
+                value_nodes_.clear();
+                if (stack_.empty()) {
+                    empty_ = false;
+                    value_nodes_.push_back(schema_.root_);
+                } else if (stack_.back().is_array) {
+                    for (auto& a : stack_.back().nodes) {
+                        const node& n = at(a.node);
+                        const std::size_t index = a.count++;
+                        const std::size_t item = index < n.prefix_items.size() ?
+                            n.prefix_items[index] : n.items;
+                        if (item != npos)
+                            value_nodes_.push_back(item);
+                    }
+                } else {
+                    value_nodes_.swap(stack_.back().member_nodes);
+                    stack_.back().member_nodes.clear();
+                }
+            }
+
+        void scalar(const ojson& value)
+            {
+                begin_value();
+                for (std::size_t i : value_nodes_) {
+                    const node& n = at(i);
+                    switch (n.kind) {
+                    case node::always_true:
+                        break;
+                    case node::always_false:
+                        valid_ = false;
+                        break;
+                    case node::compiled:
+                        valid_ = valid_ && n.schema->is_valid(value);
+                        break;
+                    case node::streamed:
+                        valid_ = valid_ && has_type(n.types, value);
+                        break;
+                    }
+                }
+            }
+
+        void begin_container(bool is_array)
+            {
+                begin_value();
+                const ojson empty = is_array ?
+                    ojson(json_array_arg) : ojson(json_object_arg);
+                frame f{is_array, {}, {}};
+                std::vector<std::size_t> compiled;
+                for (std::size_t i : value_nodes_) {
+                    const node& n = at(i);
+                    switch (n.kind) {
+                    case node::always_true:
+                        break;
+                    case node::always_false:
+                        valid_ = false;
+                        break;
+                    case node::compiled:
+                        compiled.push_back(i);
+                        break;
+                    case node::streamed:
+                        valid_ = valid_ && has_type(n.types, empty);
+                        f.nodes.push_back({i, 0, std::vector<char>(n.required.size())});
+                        break;
+                    }
+                }
+                stack_.push_back(std::move(f));
+                if (!compiled.empty()) {
+                    captures_.emplace_back(new capture(stack_.size(), std::move(compiled)));
+                }
+            }
+
+        void end_container()
+            {
+                if (!captures_.empty() && captures_.back()->depth == stack_.size()) {
+                    const ojson value = captures_.back()->decoder.get_result();
+                    for (std::size_t i : captures_.back()->nodes)
+                        valid_ = valid_ && at(i).schema->is_valid(value);
+                    captures_.pop_back();
+                }
+                const frame& f = stack_.back();
+                for (const auto& a : f.nodes) {
+                    const node& n = at(a.node);
+                    if (f.is_array) {
+                        valid_ = valid_ &&
+                            a.count >= n.min_items && a.count <= n.max_items;
+                    } else {
+                        valid_ = valid_ &&
+                            a.count >= n.min_properties &&
+                            a.count <= n.max_properties;
+                        for (char seen : a.seen)
+                            valid_ = valid_ && seen;
+                    }
+                }
+                stack_.pop_back();
+            }
+
+        void key(const std::string& name)
+            {
+                frame& f = stack_.back();
+                f.member_nodes.clear();
+                for (auto& a : f.nodes) {
+                    const node& n = at(a.node);
+                    ++a.count;
+                    for (std::size_t i = 0; i < n.required.size(); ++i)
+                        if (n.required[i] == name)
+                            a.seen[i] = 1;
+                    bool matched = false;
+                    auto it = n.properties.find(name);
+                    if (it != n.properties.end()) {
+                        f.member_nodes.push_back(it->second);
+                        matched = true;
+                    }
+                    for (const auto& pp : n.pattern_properties) {
+                        if (pp.first.search(name)) {
+                            f.member_nodes.push_back(pp.second);
+                            matched = true;
+                        }
+                    }
+                    if (!matched && n.additional_properties != npos)
+                        f.member_nodes.push_back(n.additional_properties);
+                }
+            }
+
+        // basic_json_visitor; events are also forwarded to each value
+        // being constructed
+
+        void visit_flush() override
+            {}
+
+        bool visit_begin_object(
+            semantic_tag tag, const ser_context& context,
+            std::error_code& ec) override
+            {
+                if (!valid_)
+                    return true;
+                begin_container(false);
+                for (auto& c : captures_)
+                    c->decoder.begin_object(tag, context, ec);
+                return true;
+            }
+
+        bool visit_end_object(
+            const ser_context& context, std::error_code& ec) override
+            {
+                if (!valid_)
+                    return true;
+                for (auto& c : captures_)
+                    c->decoder.end_object(context, ec);
+                end_container();
+                return true;
+            }
+
+        bool visit_begin_array(
+            semantic_tag tag, const ser_context& context,
+            std::error_code& ec) override
+            {
+                if (!valid_)
+                    return true;
+                begin_container(true);
+                for (auto& c : captures_)
+                    c->decoder.begin_array(tag, context, ec);
+                return true;
+            }
+
+        bool visit_end_array(
+            const ser_context& context, std::error_code& ec) override
+            {
+                if (!valid_)
+                    return true;
+                for (auto& c : captures_)
+                    c->decoder.end_array(context, ec);
+                end_container();
+                return true;
+            }
+
+        bool visit_key(
+            const string_view_type& name, const ser_context& context,
+            std::error_code& ec) override
+            {
+                if (!valid_)
+                    return true;
+                key(std::string(name));
+                for (auto& c : captures_)
+                    c->decoder.key(name, context, ec);
+                return true;
+            }
+
+        bool visit_null(
+            semantic_tag tag, const ser_context& context,
+            std::error_code& ec) override
+            {
+                if (!valid_)
+                    return true;
+                scalar(ojson(null_type(), tag));
+                for (auto& c : captures_)
+                    c->decoder.null_value(tag, context, ec);
+                return true;
+            }
+
+        bool visit_bool(
+            bool value, semantic_tag tag, const ser_context& context,
+            std::error_code& ec) override
+            {
+                if (!valid_)
+                    return true;
+                scalar(ojson(value, tag));
+                for (auto& c : captures_)
+                    c->decoder.bool_value(value, tag, context, ec);
+                return true;
+            }
+
+        bool visit_string(
+            const string_view_type& value, semantic_tag tag,
+            const ser_context& context, std::error_code& ec) override
+            {
+                if (!valid_)
+                    return true;
+                scalar(ojson(value, tag));
+                for (auto& c : captures_)
+                    c->decoder.string_value(value, tag, context, ec);
+                return true;
+            }
+
+        bool visit_byte_string(
+            const byte_string_view& value, semantic_tag tag,
+            const ser_context& context, std::error_code& ec) override
+            {
+                if (!valid_)
+                    return true;
+                scalar(ojson(byte_string_arg, value, tag));
+                for (auto& c : captures_)
+                    c->decoder.byte_string_value(value, tag, context, ec);
+                return true;
+            }
+
+        bool visit_uint64(
+            uint64_t value, semantic_tag tag, const ser_context& context,
+            std::error_code& ec) override
+            {
+                if (!valid_)
+                    return true;
+                scalar(ojson(value, tag));
+                for (auto& c : captures_)
+                    c->decoder.uint64_value(value, tag, context, ec);
+                return true;
+            }
+
+        bool visit_int64(
+            int64_t value, semantic_tag tag, const ser_context& context,
+            std::error_code& ec) override
+            {
+                if (!valid_)
+                    return true;
+                scalar(ojson(value, tag));
+                for (auto& c : captures_)
+                    c->decoder.int64_value(value, tag, context, ec);
+                return true;
+            }
+
+        bool visit_double(
+            double value, semantic_tag tag, const ser_context& context,
+            std::error_code& ec) override
+            {
+                if (!valid_)
+                    return true;
+                scalar(ojson(value, tag));
+                for (auto& c : captures_)
+                    c->decoder.double_value(value, tag, context, ec);
+                return true;
+            }
+
+    public:
+        evaluator(const schema_stream& schema)
+            : schema_(schema)
+            {}
+
+        bool is_valid() const
+            {
+                if (empty_)
+                    JSONCONS_THROW(ser_error(
+                        json_errc::source_error, "Failed to parse json string"));
+                return valid_;
+            }
+    };
+
+public:
+    // nullptr if 'schema' cannot be streamed, or if there is nothing
+    // to stream, i.e., the root schema is compiled
+    static std::shared_ptr<const schema_stream> make(const ojson& schema)
+        {
+            if (has_references(schema))
+                return nullptr;
+
+            std::shared_ptr<schema_stream> stream(new schema_stream());
+            // the default, as for make_json_schema()
+            stream->draft202012_ = true;
+            if (schema.is_object() && schema.contains("$schema")) {
+                const ojson& version = schema["$schema"];
+                if (!version.is_string())
+                    return nullptr;
+                const std::string version_ = version.as<std::string>();
+                stream->dialect_ = version;
+                stream->draft202012_ =
+                    version_ == jsonschema::schema_version::draft202012();
+                if (!stream->draft202012_ &&
+                    version_ != jsonschema::schema_version::draft201909() &&
+                    version_ != jsonschema::schema_version::draft7() &&
+                    version_ != jsonschema::schema_version::draft6())
+                    return nullptr;
+            }
+
+            stream->root_ = stream->add_node(schema);
+            if (stream->nodes_[stream->root_].kind == node::compiled)
+                return nullptr;
+            return stream;
+        }
+
+    // parse and validate one JSON document; parse errors are thrown as
+    // for ojson::parse()
+    bool is_valid(std::istream& is) const
+        {
+            evaluator visitor(*this);
+            json_stream_reader reader(is, visitor);
+            reader.read();
+            return visitor.is_valid();
+        }
+
+    bool is_valid(const std::string& data) const
+        {
+            record_parser parser;
+            return is_valid(data, parser);
+        }
+
+    // e.g., NDJSON records, reusing 'parser'
+    bool is_valid(const std::string& data, record_parser& parser) const
+        {
+            evaluator visitor(*this);
+            parser.parse(data, visitor);
+            return visitor.is_valid();
+        }
+
+private:
+    schema_stream()
+        : dialect_(ojson::null())
+        {}
+};
+
+#endif
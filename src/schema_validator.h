@@ -0,0 +1,334 @@
+#ifndef RJSONCONS_SCHEMA_VALIDATOR_H
+#define RJSONCONS_SCHEMA_VALIDATOR_H
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/jsonschema/jsonschema.hpp>
+
+#include "readbinbuf.h"
+#include "progressbar.h"
+#include "j_as.h"
+#include "parallel.h"
+#include "schema_errors.h"
+#include "schema_stream.h"
+#include "record_parser.h"
+#include "schema_columns.h"
+#include "typed_columns.h"
+
+#include <cpp11/sexp.hpp>
+#include <cpp11/list.hpp>
+#include <cpp11/logicals.hpp>
+#include <cpp11/function.hpp>   // 'package'
+
+using namespace jsoncons;
+using namespace rjsoncons;
+
+using compiled_schema = jsonschema::json_schema<ojson>;
+
+// shared by cached schemas and those returned by j_schema_compile()
+using compiled_schema_ptr = std::shared_ptr<const compiled_schema>;
+
+// validate NDJSON records against a schema compiled once by the
+// caller. The compiled schema is immutable, so batches of records are
+// parsed and validated in up to 'threads' threads, each writing to
+// its own range of pre-sized results; only one batch is in memory.
+// Each thread reuses one parser for all its records; is_valid()
+// validates records as they are parsed when the schema has a
+// streaming form. Reading stops early after the first invalid record
+// when 'stop_on_invalid' is true. pivot() also decodes each valid
+// record into typed columns, in record order, after its batch is
+// validated; an invalid record is an error.
+
+class schema_validator
+{
+    const compiled_schema_ptr schema_;
+    std::shared_ptr<const schema_stream> stream_;
+    const bool stop_on_invalid_;
+    const bool verbose_;
+    std::size_t threads_ = 1;
+    // validate() rather than is_valid()
+    bool validate_ = false;
+    // validate() to columns, collecting messages rather than JSON
+    bool columns_ = false;
+
+    // per-record results, in record order; errors_ (JSON) or
+    // messages_ (columns) only for validate()
+    std::vector<int> valid_;
+    std::vector<ojson> errors_;
+    std::vector<std::vector<jsonschema::validation_message>> messages_;
+
+    // pivot(): columns of valid records, and the parsed records of
+    // the current batch
+    std::unique_ptr<typed_columns<ojson>> pivot_;
+    std::vector<ojson> batch_;
+
+    // records per thread in each batch read from a connection
+    static const std::size_t batch_size = 10000;
+
+    // validate records[0, n), appending to valid_ and errors_; false
+    // if reading should stop, i.e., 'stop_on_invalid' and an invalid
+    // record was found. Results are as if validated sequentially.
+    bool validate_records(
+        const std::vector<std::string>& records, std::size_t n)
+        {
+            const std::size_t offset = valid_.size();
+            valid_.resize(offset + n);
+            resize_errors(offset + n);
+            if (pivot_)
+                batch_.resize(n);
+
+            // small batches are not worth a thread
+            const std::size_t n_threads =
+                std::min(threads_, std::max(n / 1000, std::size_t(1)));
+            // each thread's range, where it stopped, and why
+            std::vector<std::size_t> ends(n_threads), stops(n_threads);
+            std::vector<std::string> parse_errors(n_threads);
+
+            parallel_for(n, n_threads, [&](
+                std::size_t begin, std::size_t end, std::size_t t)
+            {
+                std::size_t i = begin;
+                ends[t] = end;
+                record_parser parser;
+                try {
+                    for (; i < end; ++i) {
+                        const bool valid = pivot_ ?
+                            pivot_record(records[i], offset, i, parser) :
+                            validate_record(records[i], offset + i, parser);
+                        if (!valid && (stop_on_invalid_ || pivot_))
+                            break;
+                    }
+                } catch (const std::exception& err) {
+                    parse_errors[t] = err.what();
+                }
+                stops[t] = i;
+            });
+
+            // the first thread to stop early determines the outcome
+            for (std::size_t t = 0; t < n_threads; ++t) {
+                if (stops[t] == ends[t])
+                    continue;
+                if (!parse_errors[t].empty()) {
+                    cpp11::stop(
+                        "record " + std::to_string(offset + stops[t] + 1) +
+                        ": " + parse_errors[t]);
+                }
+                if (pivot_) {
+                    cpp11::stop(
+                        "record " + std::to_string(offset + stops[t] + 1) +
+                        " is not valid; see `j_schema_validate()`");
+                }
+                // invalid record; discard results after it
+                valid_.resize(offset + stops[t] + 1);
+                resize_errors(offset + stops[t] + 1);
+                return false;
+            }
+
+            if (pivot_) {
+                for (std::size_t i = 0; i < n; ++i)
+                    pivot_row(std::move(batch_[i]));
+            }
+
+            return true;
+        }
+
+    void resize_errors(std::size_t n)
+        {
+            if (columns_) {
+                messages_.resize(n);
+            } else if (validate_) {
+                errors_.resize(n);
+            }
+        }
+
+    // called from worker threads; no R API
+    bool validate_record(
+        const std::string& record, std::size_t i, record_parser& parser)
+        {
+            if (!validate_ && stream_) {
+                valid_[i] = stream_->is_valid(record, parser);
+                return valid_[i];
+            }
+
+            const ojson j = parser.parse(record);
+            if (!validate_) {
+                valid_[i] = schema_->is_valid(j);
+            } else if (columns_) {
+                auto& messages = messages_[i];
+                schema_->validate(j, [&](
+                    const jsonschema::validation_message& message)
+                {
+                    messages.push_back(message);
+                });
+                valid_[i] = messages.empty();
+            } else {
+                json_decoder<ojson> decoder;
+                schema_->validate(j, decoder);
+                errors_[i] = decoder.get_result();
+                valid_[i] = errors_[i].empty();
+            }
+            return valid_[i];
+        }
+
+    // called from worker threads; 'i' indexes the batch
+    bool pivot_record(
+        const std::string& record, std::size_t offset, std::size_t i,
+        record_parser& parser)
+        {
+            batch_[i] = parser.parse(record);
+            valid_[offset + i] = schema_->is_valid(batch_[i]);
+            return valid_[offset + i];
+        }
+
+    // each record is a row; members without a column are ignored, and
+    // records that are not objects are rows of NA
+    void pivot_row(ojson&& record)
+        {
+            if (record.is_object()) {
+                for (auto& member : record.object_range())
+                    pivot_->set(member.key(), std::move(member.value()));
+            }
+            pivot_->end_row();
+        }
+
+    void do_strings(const std::vector<std::string>& data)
+        {
+            validate_records(data, data.size());
+        }
+
+    // one record per line; blank lines are skipped
+    void do_connection(const sexp& con, double n_records)
+        {
+            readbinbuf cbuf(con);
+            std::istream is(&cbuf);
+            progressbar progress("validating {cli::pb_current} records");
+
+            std::vector<std::string> batch(threads_ * batch_size);
+            double n = 0;
+            bool more = true;
+            while (more && n < n_records) {
+                std::size_t n_batch = 0;
+                while (n_batch < batch.size() && n < n_records &&
+                       std::getline(is, batch[n_batch]))
+                {
+                    const auto& line = batch[n_batch];
+                    if (line.find_first_not_of(" \t\r") == std::string::npos)
+                        continue;
+                    ++n_batch;
+                    n += 1;
+                }
+                if (n_batch == 0)
+                    break;
+                more = validate_records(batch, n_batch);
+                if (verbose_) {
+                    for (std::size_t i = 0; i < n_batch; ++i)
+                        progress.tick();
+                }
+            }
+        }
+
+    sexp as_valid() const
+        {
+            writable::logicals result(valid_.size());
+            for (std::size_t i = 0; i < valid_.size(); ++i)
+                result[i] = valid_[i];
+            return result;
+        }
+
+    // 'as' is "string" or "R" for one element per record, or
+    // "columns" or "details" for columns of all errors, or their
+    // details, with their 'record_id'
+    sexp as_errors(const std::string& as)
+        {
+            if (columns_) {
+                schema_errors errors(as == "details");
+                for (std::size_t i = 0; i < messages_.size(); ++i) {
+                    for (const auto& message : messages_[i])
+                        errors.add(message, static_cast<int>(i + 1));
+                }
+                return errors.as_r(true);
+            }
+
+            const auto as_ = enum_index(as_map, as);
+            writable::list result(errors_.size());
+            for (std::size_t i = 0; i < errors_.size(); ++i)
+                result[i] = j_as(errors_[i], as_);
+
+            return as_ == as::string ?
+                package("base")["unlist"](result) : result;
+        }
+
+public:
+    schema_validator(
+        compiled_schema_ptr schema, bool stop_on_invalid, bool verbose)
+        : schema_(schema),
+          stop_on_invalid_(stop_on_invalid),
+          verbose_(verbose)
+        {}
+
+    schema_validator& threads(int n)
+        {
+            threads_ = std::max(n, 1);
+            return *this;
+        }
+
+    // for is_valid(); nullptr when the schema cannot be streamed
+    schema_validator& stream(std::shared_ptr<const schema_stream> stream)
+        {
+            stream_ = stream;
+            return *this;
+        }
+
+    sexp is_valid(const std::vector<std::string>& data)
+        {
+            do_strings(data);
+            return as_valid();
+        }
+
+    sexp is_valid(const sexp& con, double n_records)
+        {
+            do_connection(con, n_records);
+            return as_valid();
+        }
+
+    sexp validate(const std::vector<std::string>& data, const std::string& as)
+        {
+            validate_ = true;
+            columns_ = as == "columns" || as == "details";
+            do_strings(data);
+            return as_errors(as);
+        }
+
+    sexp validate(const sexp& con, double n_records, const std::string& as)
+        {
+            validate_ = true;
+            columns_ = as == "columns" || as == "details";
+            do_connection(con, n_records);
+            return as_errors(as);
+        }
+
+    sexp pivot(
+        const std::vector<std::string>& data, const schema_columns& columns)
+        {
+            pivot_.reset(
+                new typed_columns<ojson>(columns.names, columns.types));
+            pivot_->reserve(data.size());
+            do_strings(data);
+            return pivot_->as_r();
+        }
+
+    sexp pivot(
+        const sexp& con, double n_records, const schema_columns& columns)
+        {
+            pivot_.reset(
+                new typed_columns<ojson>(columns.names, columns.types));
+            do_connection(con, n_records);
+            return pivot_->as_r();
+        }
+};
+
+#endif
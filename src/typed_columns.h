@@ -0,0 +1,264 @@
+#ifndef RJSONCONS_TYPED_COLUMNS_H
+#define RJSONCONS_TYPED_COLUMNS_H
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+
+#include "enum_index.h"
+#include "j_as.h"
+
+#include <cpp11/list.hpp>
+#include <cpp11/logicals.hpp>
+#include <cpp11/integers.hpp>
+#include <cpp11/doubles.hpp>
+#include <cpp11/strings.hpp>
+#include <cpp11/protect.hpp>    // stop
+
+using namespace jsoncons;
+using namespace rjsoncons;
+
+// columns of declared type, e.g., j_pivot(col_types = ). Rows are
+// added one member at a time; values are coerced to the column type
+// as they are added, rather than inferring the type from all values.
+// Values that cannot be coerced, and members missing from a row, are
+// NA; keys without a column are ignored.
+
+template<class Json>
+class typed_columns
+{
+    struct column {
+        col_type type;
+        std::vector<int> ints;          // logical, integer
+        std::vector<double> doubles;    // numeric
+        std::vector<std::string> strings; // character; 'na' marks NA
+        std::vector<bool> na;
+        std::vector<Json> values;       // list
+        std::size_t n = 0;              // values, including NA
+    };
+
+    std::vector<std::string> names_;
+    std::vector<column> columns_;
+    std::unordered_map<std::string, std::size_t> index_;
+    std::size_t n_rows_ = 0;
+
+    // coercion, following R's as.logical() etc. for JSON scalars
+    static int as_logical(const Json& j)
+        {
+            switch(j.type()) {
+            case json_type::bool_value:
+                return j.template as<bool>();
+            case json_type::int64_value:
+            case json_type::uint64_value:
+            case json_type::double_value:
+                return j.template as<double>() != 0;
+            default:
+                return NA_LOGICAL;
+            }
+        }
+
+    static int as_integer(const Json& j)
+        {
+            switch(j.type()) {
+            case json_type::bool_value:
+                return j.template as<bool>();
+            case json_type::int64_value: {
+                const int64_t value = j.template as<int64_t>();
+                return is_integer(value) ?
+                    static_cast<int>(value) : NA_INTEGER;
+            }
+            case json_type::uint64_value: {
+                const uint64_t value = j.template as<uint64_t>();
+                const uint64_t int_max = std::numeric_limits<int>::max();
+                return value <= int_max ?
+                    static_cast<int>(value) : NA_INTEGER;
+            }
+            case json_type::double_value: {
+                // only whole numbers in range; no truncation
+                const double value = j.template as<double>();
+                const bool is_int32 =
+                    std::trunc(value) == value &&
+                    value > std::numeric_limits<int>::min() &&
+                    value <= std::numeric_limits<int>::max();
+                return is_int32 ? static_cast<int>(value) : NA_INTEGER;
+            }
+            default:
+                return NA_INTEGER;
+            }
+        }
+
+    static double as_numeric(const Json& j)
+        {
+            switch(j.type()) {
+            case json_type::bool_value:
+                return j.template as<bool>();
+            case json_type::int64_value:
+            case json_type::uint64_value:
+            case json_type::double_value:
+                return j.template as<double>();
+            default:
+                return NA_REAL;
+            }
+        }
+
+    void append(column& col, Json&& value)
+        {
+            switch(col.type) {
+            case logical_col_type: {
+                col.ints.push_back(as_logical(value));
+                break;
+            }
+            case integer_col_type: {
+                col.ints.push_back(as_integer(value));
+                break;
+            }
+            case numeric_col_type: {
+                col.doubles.push_back(as_numeric(value));
+                break;
+            }
+            case character_col_type: {
+                // strings as-is; other values as JSON text
+                const bool is_na = value.is_null();
+                col.na.push_back(is_na);
+                if (is_na) {
+                    col.strings.emplace_back();
+                } else if (value.is_string()) {
+                    col.strings.push_back(value.template as<std::string>());
+                } else {
+                    col.strings.push_back(value.to_string());
+                }
+                break;
+            }
+            case list_col_type: {
+                col.values.push_back(std::move(value));
+                break;
+            }}
+            ++col.n;
+        }
+
+public:
+    typed_columns(
+        const std::vector<std::string>& names,
+        const std::vector<std::string>& types)
+        : names_(names)
+        {
+            if (names.size() != types.size())
+                cpp11::stop("column 'names' and 'types' must have equal length");
+            columns_.resize(names.size());
+            for (std::size_t i = 0; i < names.size(); ++i) {
+                columns_[i].type = enum_index(col_type_map, types[i]);
+                if (!index_.emplace(names[i], i).second)
+                    cpp11::stop("duplicate column name '" + names[i] + "'");
+            }
+        }
+
+    void reserve(std::size_t n)
+        {
+            for (auto& col : columns_) {
+                switch(col.type) {
+                case logical_col_type:
+                case integer_col_type: {
+                    col.ints.reserve(n);
+                    break;
+                }
+                case numeric_col_type: {
+                    col.doubles.reserve(n);
+                    break;
+                }
+                case character_col_type: {
+                    col.strings.reserve(n);
+                    col.na.reserve(n);
+                    break;
+                }
+                case list_col_type: {
+                    col.values.reserve(n);
+                    break;
+                }}
+            }
+        }
+
+    // add 'value' to column 'key' of the current row; false if 'key'
+    // already has a value in this row
+    bool set(const std::string& key, Json&& value)
+        {
+            auto it = index_.find(key);
+            if (it == index_.end())
+                return true;
+            column& col = columns_[it->second];
+            if (col.n > n_rows_)
+                return false;
+            append(col, std::move(value));
+            return true;
+        }
+
+    // complete the current row; columns without a value are NA
+    void end_row()
+        {
+            ++n_rows_;
+            for (auto& col : columns_) {
+                if (col.n < n_rows_)
+                    append(col, Json(Json::null()));
+            }
+        }
+
+    // named list of R vectors
+    sexp as_r() const
+        {
+            writable::list result(columns_.size());
+            writable::strings names(columns_.size());
+            for (std::size_t k = 0; k < columns_.size(); ++k) {
+                const column& col = columns_[k];
+                names[k] = names_[k];
+                switch(col.type) {
+                case logical_col_type: {
+                    writable::logicals values(col.n);
+                    for (std::size_t i = 0; i < col.n; ++i)
+                        values[i] = col.ints[i];
+                    result[k] = values;
+                    break;
+                }
+                case integer_col_type: {
+                    writable::integers values(col.n);
+                    std::copy(col.ints.cbegin(), col.ints.cend(), values.begin());
+                    result[k] = values;
+                    break;
+                }
+                case numeric_col_type: {
+                    writable::doubles values(col.n);
+                    std::copy(
+                        col.doubles.cbegin(), col.doubles.cend(),
+                        values.begin());
+                    result[k] = values;
+                    break;
+                }
+                case character_col_type: {
+                    writable::strings values(col.n);
+                    for (std::size_t i = 0; i < col.n; ++i) {
+                        if (col.na[i]) {
+                            values[i] = NA_STRING;
+                        } else {
+                            values[i] = col.strings[i];
+                        }
+                    }
+                    result[k] = values;
+                    break;
+                }
+                case list_col_type: {
+                    writable::list values(col.n);
+                    for (std::size_t i = 0; i < col.n; ++i)
+                        values[i] = j_as_r(col.values[i]);
+                    result[k] = values;
+                    break;
+                }}
+            }
+            result.names() = names;
+
+            return result;
+        }
+};
+
+#endif
@@ -0,0 +1,485 @@
+#ifndef RJSONCONS_UNFLATTEN_H
+#define RJSONCONS_UNFLATTEN_H
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+
+#include "enum_index.h"
+
+#include <cpp11/doubles.hpp>
+#include <cpp11/integers.hpp>
+#include <cpp11/list.hpp>
+#include <cpp11/logicals.hpp>
+#include <cpp11/sexp.hpp>
+#include <cpp11/strings.hpp>
+#include <cpp11/protect.hpp>    // 'stop'
+
+using namespace jsoncons;
+using namespace rjsoncons;
+using namespace cpp11;
+
+// j_unflatten(): rebuild a document from JSONpointer or JSONpath
+// path / value pairs, e.g., from j_flatten(). Paths are parsed once;
+// pairs are visited in an order where each container's descendants
+// are contiguous, so each container is constructed once, in bulk, when
+// its last descendant has been seen.
+
+template<class Json>
+class unflattener
+{
+    struct segment {
+        std::string key;        // unescaped key, or array index digits
+        std::size_t end;        // offset in path after this segment
+        bool is_index;          // JSONpath '[0]'
+        std::size_t index;
+    };
+
+    struct frame {
+        std::string path;
+        std::vector<std::pair<std::string, Json>> members;
+        std::vector<std::size_t> indices; // JSONpath array indices
+        bool has_key = false;
+    };
+
+    const rjsoncons::path_type path_type_;
+
+    std::vector<std::string> paths_;
+    std::vector<Json> values_;
+    // segments of paths_[i] are segments_[offsets_[i]], ...
+    std::vector<segment> segments_;
+    std::vector<std::size_t> offsets_;
+
+    static bool is_index(const std::string& key, std::size_t& index)
+        {
+            // canonical non-negative integer, e.g., "0" but not "01"
+            if (key.empty() || key.size() > 18 || (key[0] == '0' && key.size() > 1))
+                return false;
+            index = 0;
+            for (const char c : key) {
+                if (c < '0' || c > '9')
+                    return false;
+                index = 10 * index + (c - '0');
+            }
+            return true;
+        }
+
+    void invalid_path(const std::string& path) const
+        {
+            if (path_type_ == path_type::JSONpointer) {
+                cpp11::stop("invalid JSONpointer path '%s'", path.c_str());
+            } else {
+                cpp11::stop(
+                    "invalid JSONpath path '%s'; expected a normalized path, "
+                    "e.g., \"$['a'][0]\"", path.c_str());
+            }
+        }
+
+    void parse_jsonpointer(const std::string& path)
+        {
+            if (path.empty())
+                return;
+            if (path[0] != '/')
+                invalid_path(path);
+
+            segment s{ "", 0, false, 0 };
+            for (std::size_t i = 1; i <= path.size(); ++i) {
+                if (i == path.size() || path[i] == '/') {
+                    s.end = i;
+                    segments_.push_back(s);
+                    s.key.clear();
+                } else if (path[i] == '~') {
+                    ++i;
+                    if (i == path.size() || (path[i] != '0' && path[i] != '1'))
+                        invalid_path(path);
+                    s.key.push_back(path[i] == '0' ? '~' : '/');
+                } else {
+                    s.key.push_back(path[i]);
+                }
+            }
+        }
+
+    void parse_jsonpath(const std::string& path)
+        {
+            // $, $['key'], $[0], ... as produced by jsonpath::flatten()
+            if (path.empty() || path[0] != '$')
+                invalid_path(path);
+
+            std::size_t i = 1;
+            while (i < path.size()) {
+                segment s{ "", 0, false, 0 };
+                if (path[i++] != '[' || i == path.size())
+                    invalid_path(path);
+                if (path[i] == '\'') {
+                    for (++i; i < path.size() && path[i] != '\''; ++i) {
+                        if (path[i] != '\\') {
+                            s.key.push_back(path[i]);
+                            continue;
+                        }
+                        if (++i == path.size())
+                            invalid_path(path);
+                        switch(path[i]) {
+                        case 'b': s.key.push_back('\b'); break;
+                        case 'f': s.key.push_back('\f'); break;
+                        case 'n': s.key.push_back('\n'); break;
+                        case 'r': s.key.push_back('\r'); break;
+                        case 't': s.key.push_back('\t'); break;
+                        default: s.key.push_back(path[i]); break;
+                        }
+                    }
+                    ++i;                // closing quote
+                } else {
+                    for (; i < path.size() && path[i] != ']'; ++i)
+                        s.key.push_back(path[i]);
+                    s.is_index = true;
+                    if (!is_index(s.key, s.index))
+                        invalid_path(path);
+                }
+                if (i >= path.size() || path[i++] != ']')
+                    invalid_path(path);
+                s.end = i;
+                segments_.push_back(std::move(s));
+            }
+        }
+
+    std::size_t depth(std::size_t i) const
+        {
+            return offsets_[i + 1] - offsets_[i];
+        }
+
+    const segment& segment_at(std::size_t i, std::size_t j) const
+        {
+            return segments_[offsets_[i] + j];
+        }
+
+    // the path of the container holding segment 'j' of path 'i'
+    std::string prefix(std::size_t i, std::size_t j) const
+        {
+            if (j == 0)
+                return path_type_ == path_type::JSONpointer ? "" : "$";
+            return paths_[i].substr(0, segment_at(i, j - 1).end);
+        }
+
+    std::size_t common_depth(std::size_t i, std::size_t j) const
+        {
+            const std::size_t n = std::min(depth(i), depth(j));
+            std::size_t k = 0;
+            while (k < n) {
+                const segment& a = segment_at(i, k);
+                const segment& b = segment_at(j, k);
+                if (a.is_index != b.is_index || a.key != b.key)
+                    break;
+                ++k;
+            }
+            return k;
+        }
+
+    // are the descendants of each container contiguous? Only the
+    // paths of closed containers are remembered
+    bool is_grouped() const
+        {
+            std::unordered_set<std::string> closed;
+            for (std::size_t cur = 1; cur < paths_.size(); ++cur) {
+                const std::size_t prev = cur - 1;
+                const std::size_t c = common_depth(prev, cur);
+                const std::size_t m = depth(prev), k = depth(cur);
+                if (c == m || c == k)
+                    continue;   // conflict, reported by build()
+                for (std::size_t j = m - 1; j > c; --j)
+                    closed.insert(prefix(prev, j));
+                for (std::size_t j = c + 1; j < k; ++j) {
+                    if (closed.count(prefix(cur, j)))
+                        return false;
+                }
+            }
+            return true;
+        }
+
+    // stable order grouping descendants of each container; siblings
+    // are ordered by first appearance, or by JSONpath array index
+    void regroup(std::vector<std::size_t>& order) const
+        {
+            std::unordered_map<std::string, std::size_t> ids;
+            std::vector<std::vector<std::size_t>> keys(paths_.size());
+            for (std::size_t i = 0; i < paths_.size(); ++i) {
+                std::size_t parent = 0;
+                keys[i].reserve(depth(i));
+                for (std::size_t j = 0; j < depth(i); ++j) {
+                    const segment& s = segment_at(i, j);
+                    std::string id = std::to_string(parent);
+                    id.push_back(s.is_index ? '[' : '.');
+                    id.append(s.key);
+                    auto it = ids.emplace(std::move(id), ids.size() + 1).first;
+                    parent = it->second;
+                    keys[i].push_back(s.is_index ? s.index : parent);
+                }
+            }
+            std::stable_sort(
+                order.begin(), order.end(),
+                [&keys](std::size_t i, std::size_t j) {
+                    return keys[i] < keys[j];
+                });
+        }
+
+    void add_member(frame& f, const segment& s, Json&& value) const
+        {
+            f.members.emplace_back(s.key, std::move(value));
+            if (s.is_index) {
+                f.indices.push_back(s.index);
+            } else {
+                f.has_key = true;
+            }
+        }
+
+    // construct the array or object, in bulk, from a frame's members
+    Json close(frame& f) const
+        {
+            const std::size_t n = f.members.size();
+            std::vector<std::size_t> slot;
+
+            if (path_type_ == path_type::JSONpath && !f.indices.empty()) {
+                // explicit array indices, in index order
+                if (f.has_key)
+                    cpp11::stop(
+                        "path '%s' has both array indices and object keys",
+                        f.path.c_str());
+                slot.resize(n);
+                std::iota(slot.begin(), slot.end(), 0);
+                std::stable_sort(
+                    slot.begin(), slot.end(),
+                    [&f](std::size_t i, std::size_t j) {
+                        return f.indices[i] < f.indices[j];
+                    });
+                // indices 0, 1, ..., n - 1; a gap names the first
+                // missing element
+                for (std::size_t i = 0; i < n; ++i) {
+                    if (i > 0 && f.indices[slot[i - 1]] == f.indices[slot[i]])
+                        cpp11::stop("duplicate paths in '%s'", f.path.c_str());
+                    if (f.indices[slot[i]] > i)
+                        cpp11::stop(
+                            "path '%s[%d]' is missing from array '%s'",
+                            f.path.c_str(), static_cast<int>(i),
+                            f.path.c_str());
+                }
+            } else if (path_type_ == path_type::JSONpointer) {
+                // an array when keys are "0", "1", ..., in any order
+                const std::size_t npos = std::numeric_limits<std::size_t>::max();
+                slot.assign(n, npos);
+                for (std::size_t i = 0; i < n; ++i) {
+                    std::size_t index;
+                    if (!is_index(f.members[i].first, index) ||
+                        index >= n || slot[index] != npos)
+                    {
+                        slot.clear();
+                        break;
+                    }
+                    slot[index] = i;
+                }
+            }
+
+            if (!slot.empty()) {
+                Json result(json_array_arg);
+                result.reserve(n);
+                for (const std::size_t i : slot)
+                    result.push_back(std::move(f.members[i].second));
+                return result;
+            }
+
+            Json result(
+                json_object_arg,
+                std::make_move_iterator(f.members.begin()),
+                std::make_move_iterator(f.members.end()));
+            if (result.size() != n)
+                cpp11::stop("duplicate paths in '%s'", f.path.c_str());
+            return result;
+        }
+
+    Json build(const std::vector<std::size_t>& order)
+        {
+            std::vector<frame> stack;
+            std::size_t prev = 0;
+
+            for (std::size_t o = 0; o < order.size(); ++o) {
+                const std::size_t cur = order[o];
+                const std::size_t k = depth(cur);
+                std::size_t c = 0;
+
+                if (o > 0) {
+                    const std::size_t m = depth(prev);
+                    c = common_depth(prev, cur);
+                    if (c == m || c == k)
+                        cpp11::stop(
+                            "path '%s' conflicts with path '%s'",
+                            paths_[cur].c_str(), paths_[prev].c_str());
+                    // close containers below the common prefix
+                    while (stack.size() > c + 1) {
+                        Json value = close(stack.back());
+                        stack.pop_back();
+                        add_member(
+                            stack.back(), segment_at(prev, stack.size() - 1),
+                            std::move(value));
+                    }
+                } else if (k == 0) {
+                    // a scalar (or empty container) document
+                    if (order.size() > 1)
+                        cpp11::stop(
+                            "path '%s' conflicts with other paths",
+                            paths_[cur].c_str());
+                    return std::move(values_[cur]);
+                }
+
+                // open containers for the remainder of the path
+                for (std::size_t j = stack.size(); j < k; ++j) {
+                    stack.emplace_back();
+                    stack.back().path = prefix(cur, j);
+                }
+                add_member(
+                    stack.back(), segment_at(cur, k - 1),
+                    std::move(values_[cur]));
+                prev = cur;
+            }
+
+            while (stack.size() > 1) {
+                Json value = close(stack.back());
+                stack.pop_back();
+                add_member(
+                    stack.back(), segment_at(prev, stack.size() - 1),
+                    std::move(value));
+            }
+            return close(stack.back());
+        }
+
+public:
+    unflattener(rjsoncons::path_type path_type)
+        : path_type_(path_type)
+        {
+            if (path_type_ == path_type::JMESpath)
+                cpp11::stop("unsupported 'path_type' JMESpath");
+        }
+
+    void push_back(std::string path, Json&& value)
+        {
+            paths_.push_back(std::move(path));
+            values_.push_back(std::move(value));
+        }
+
+    // build the document from path / value pairs added with
+    // push_back(), and reset for the next document
+    Json get_result()
+        {
+            const std::size_t n = paths_.size();
+            Json result(json_object_arg);
+
+            if (n) {
+                segments_.clear();
+                offsets_.clear();
+                offsets_.reserve(n + 1);
+                offsets_.push_back(0);
+                for (const auto& path : paths_) {
+                    if (path_type_ == path_type::JSONpointer) {
+                        parse_jsonpointer(path);
+                    } else {
+                        parse_jsonpath(path);
+                    }
+                    offsets_.push_back(segments_.size());
+                }
+
+                std::vector<std::size_t> order(n);
+                std::iota(order.begin(), order.end(), 0);
+                if (!is_grouped())
+                    regroup(order);
+                result = build(order);
+            }
+
+            paths_.clear();
+            values_.clear();
+            segments_.clear();
+            offsets_.clear();
+            return result;
+        }
+
+    // unflatten a flat object, e.g., from j_flatten()
+    Json unflatten(Json&& flat)
+        {
+            if (!flat.is_object())
+                cpp11::stop("flattened JSON must be an object");
+            for (auto& member : flat.object_range())
+                push_back(std::string(member.key()), std::move(member.value()));
+            return get_result();
+        }
+};
+
+// an R 'value' column, as from j_flatten(as = "data.frame"), as JSON;
+// NA is null, and list elements are NULL, length 1 atomic vectors, or
+// empty lists (arrays) or named lists (objects)
+
+template<class Json>
+std::vector<Json> r_column_as_json(const sexp& column)
+{
+    std::vector<Json> values;
+    values.reserve(Rf_xlength(column));
+
+    switch(TYPEOF(column)) {
+    case LGLSXP: {
+        for (const auto value : logicals(column)) {
+            const int x = static_cast<int>(value);
+            values.push_back(
+                x == NA_LOGICAL ? Json::null() : Json(x != 0));
+        }
+        break;
+    }
+    case INTSXP: {
+        for (const int value : integers(column))
+            values.push_back(
+                value == NA_INTEGER ? Json::null() : Json(value));
+        break;
+    }
+    case REALSXP: {
+        for (const double value : doubles(column))
+            values.push_back(ISNAN(value) ? Json::null() : Json(value));
+        break;
+    }
+    case STRSXP: {
+        for (const auto& value : strings(column))
+            values.push_back(
+                static_cast<SEXP>(value) == NA_STRING ?
+                Json::null() : Json(static_cast<std::string>(value)));
+        break;
+    }
+    case VECSXP: {
+        for (const SEXP value : list(column)) {
+            const R_xlen_t n = Rf_xlength(value);
+            if (Rf_isNull(value)) {
+                values.push_back(Json::null());
+            } else if (TYPEOF(value) == VECSXP && n == 0) {
+                values.push_back(
+                    Rf_isNull(Rf_getAttrib(value, R_NamesSymbol)) ?
+                    Json(json_array_arg) : Json(json_object_arg));
+            } else if (TYPEOF(value) != VECSXP && n == 1) {
+                values.push_back(r_column_as_json<Json>(value)[0]);
+            } else {
+                cpp11::stop(
+                    "'value' list elements must be NULL, length 1 "
+                    "vectors, or empty lists");
+            }
+        }
+        break;
+    }
+    default: {
+        cpp11::stop(
+            "'value' must be a logical, integer, numeric, character, "
+            "or list vector");
+    }}
+
+    return values;
+}
+
+#endif